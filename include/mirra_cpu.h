@@ -20,8 +20,12 @@
 #ifndef MIRRA_CPU_H_
 #define MIRRA_CPU_H_
 
-#include "../include/mirra_bus.h"
-#include "../include/mirra_singleton.h"
+#include <fstream>
+#include <map>
+#include <set>
+#include <vector>
+#include "../include/mirra_mmu.h"
+#include "../include/mirra_trace.h"
 
 namespace mirra {
 
@@ -43,11 +47,56 @@ namespace mirra {
 
 	#define ADDRESS_MAX ADDRESS_ZERO_PAGE_Y
 
+	enum {
+		CPU_PARAMETER_ENGINE = 0,
+	};
+
+	#define CPU_PARAMETER_MAX CPU_PARAMETER_ENGINE
+
+	typedef enum {
+		CPU_EVENT_NONE = 0,
+		CPU_EVENT_BREAKPOINT,
+		CPU_EVENT_FRAME,
+		CPU_EVENT_HALT,
+		CPU_EVENT_INTERRUPT,
+	} cpu_event_t;
+
+	#define CPU_EVENT_MAX CPU_EVENT_INTERRUPT
+
+	#define CPU_SLICE_CYCLES 29781
+
+	typedef struct {
+		uint8_t accumulator;
+		uint8_t flag;
+		uint8_t index_x;
+		uint8_t index_y;
+		uint16_t program_counter;
+		uint8_t stack_pointer;
+	} cpu_register_t;
+
+	typedef enum {
+		INTERRUPT_LINE_APU = 0,
+		INTERRUPT_LINE_DMC,
+		INTERRUPT_LINE_MAPPER,
+		INTERRUPT_LINE_NMI,
+	} interrupt_line_t;
+
+	#define INTERRUPT_LINE_MAX INTERRUPT_LINE_NMI
+
+	typedef enum {
+		ENGINE_TABLE = 0,
+		ENGINE_THREADED,
+		ENGINE_DECODE,
+		ENGINE_DYNAREC,
+	} engine_t;
+
+	#define ENGINE_MAX ENGINE_DYNAREC
+
 	enum {
 		FLAG_CARRY = 0,
 		FLAG_ZERO,
 		FLAG_INTERRUPT_DISABLE,
-		FLAG_UNUSED_0,
+		FLAG_DECIMAL,
 		FLAG_INTERRUPT_ACTIVE,
 		FLAG_UNUSED_1,
 		FLAG_OVERFLOW,
@@ -60,29 +109,156 @@ namespace mirra {
 		uint8_t carry : 1;
 		uint8_t zero : 1;
 		uint8_t interrupt_disable : 1;
-		uint8_t unused_0 : 1;
+		uint8_t decimal : 1;
 		uint8_t interrupt_active : 1;
 		uint8_t unused_1 : 1;
 		uint8_t overflow : 1;
 		uint8_t sign : 1;
 		});
 
+	typedef struct {
+		uint16_t address;
+		uint16_t branch;
+		uint32_t generation;
+		bool pure;
+		bool valid;
+		uint64_t cycles;
+		uint8_t accumulator;
+		uint8_t flag;
+		uint8_t index_x;
+		uint8_t index_y;
+		uint8_t stack_pointer;
+	} idle_t;
+
+	class cpu;
+
+	typedef void (mirra::cpu::*instruction_cb)(
+		__in uint16_t operand
+		);
+
+	typedef struct {
+		mirra::instruction_cb handler;
+		mirra::address_t mode;
+		uint8_t length;
+		uint8_t cycles;
+		uint8_t boundary;
+		const char *name;
+	} instruction_t;
+
+	#define INSTRUCTION_MAX UINT8_MAX
+
+	typedef struct {
+		const mirra::instruction_t *entry;
+		uint16_t operand;
+	} decode_t;
+
+	#define DECODE_BLOCK_MAX 16
+
+	typedef struct {
+		const uint8_t *source;
+		uint16_t address;
+		uint8_t count;
+		uint8_t hits;
+		uint8_t *native;
+		mirra::decode_t instruction[DECODE_BLOCK_MAX];
+	} decode_block_t;
+
+	#define DECODE_CACHE_SIZE 1024
+	#define DECODE_CACHE_MASK (DECODE_CACHE_SIZE - 1)
+
+#if TRACE >= TRACE_PROFILE
+	typedef struct {
+		uint64_t count;
+		uint64_t cycles;
+	} profile_t;
+
+	typedef struct {
+		uint32_t parent;
+		uint32_t key;
+		mirra::profile_t total;
+		std::map<uint32_t, uint32_t> child;
+	} profile_frame_t;
+#endif // TRACE >= TRACE_PROFILE
+
 	class cpu :
 			public mirra::singleton<mirra::cpu>,
-			public mirra::bus {
+			public mirra::mmu_handler {
 
 		public:
 
 			~cpu(void);
 
+			void breakpoint_add(
+				__in uint16_t address
+				);
+
+			void breakpoint_clear(void);
+
+			void breakpoint_remove(
+				__in uint16_t address
+				);
+
+			uint64_t cycles(void);
+
+			mirra::cpu_event_t event(void);
+
 			void initialize(
 				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
 				);
 
+			static const mirra::instruction_t &instruction(
+				__in uint8_t opcode
+				);
+
+			void interrupt_assert(
+				__in mirra::interrupt_line_t line
+				);
+
+			void interrupt_release(
+				__in mirra::interrupt_line_t line
+				);
+
+			bool is_halted(void);
+
 			bool is_initialized(void);
 
 			bool is_started(void);
 
+			void limit(
+				__in uint64_t cycle
+				);
+
+#if TRACE >= TRACE_PROFILE
+			void profile_clear(void);
+
+			void profile_export(
+				__in const std::string &path,
+				__in_opt bool collapsed = false
+				);
+#endif // TRACE >= TRACE_PROFILE
+
+			void raise(
+				__in mirra::cpu_event_t event
+				);
+
+			mirra::cpu_register_t registers(void);
+
+			void registers(
+				__in const mirra::cpu_register_t &value
+				);
+
+			mirra::cpu_event_t run_for(
+				__in uint32_t cycles
+				);
+
+			mirra::cpu_event_t run_until(
+				__in mirra::cpu_event_t event
+				);
+
+			void stall(
+				__in uint32_t cycles
+				);
+
 			void start(
 				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
 				);
@@ -95,7 +271,7 @@ namespace mirra {
 
 			void uninitialize(void);
 
-			void update(void);
+			mirra::status_t update(void);
 
 		protected:
 
@@ -111,12 +287,469 @@ namespace mirra {
 				__in const cpu &other
 				);
 
+			void add(
+				__in uint8_t value
+				);
+
+			void branch(
+				__in bool condition,
+				__in uint16_t operand
+				);
+
 			void clear(void);
 
-			uint16_t indirect_address(
-				__in mirra::address_t mode,
+			void compare(
+				__in uint8_t left,
+				__in uint8_t right
+				);
+
+			mirra::decode_block_t &decode(
+				__in uint16_t address
+				);
+
+			void dynarec_allocate(void);
+
+			void dynarec_flush(void);
+
+			void dynarec_free(void);
+
+			bool dynarec_translate(
+				__in mirra::decode_block_t &block
+				);
+
+			void execute(
+				__in const mirra::instruction_t &entry,
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_adc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_alr(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_anc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_and(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_ane(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_arr(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_asl(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bcc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bcs(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_beq(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bit(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bmi(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bne(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bpl(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_brk(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bvc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_bvs(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_clc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_cld(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_cli(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_clv(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_cmp(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_cpx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_cpy(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_dcp(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_dec(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_dex(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_dey(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_eor(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_inc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_inx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_iny(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_isc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_jam(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_jmp(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_jsr(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_las(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_lax(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_lda(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_ldx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_ldy(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_lsr(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_lxa(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_nop(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_ora(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_pha(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_php(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_pla(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_plp(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_rla(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_rol(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_ror(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_rra(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_rti(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_rts(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sax(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sbc(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sbx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sec(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sed(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sei(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sha(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_shx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_shy(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_slo(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sre(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sta(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_stx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_sty(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_tas(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_tax(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_tay(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_tsx(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_txa(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_txs(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			void execute_tya(
+				__in uint16_t operand
+				);
+
+			template <mirra::address_t MODE>
+			uint8_t fetch(
+				__in uint16_t operand
+				);
+
+			uint8_t flag_pack(void);
+
+			void flag_unpack(
+				__in uint8_t value
+				);
+
+			void idle(
 				__in uint16_t address,
-				__out bool &boundary
+				__in uint16_t branch
+				);
+
+			bool idle_pure(
+				__in uint16_t address,
+				__in uint16_t branch
+				);
+
+			template <mirra::address_t MODE>
+			uint16_t indirect_address(
+				__in uint16_t address
+				);
+
+			void interrupt(void);
+
+			void interrupt_poll(
+				__in bool delay
+				);
+
+			mirra::cpu_event_t interpret(
+				__in uint32_t cycles
+				);
+
+			void interpret_breakpoint(void);
+
+			void interpret_decode(void);
+
+			void interpret_dynarec(void);
+
+			void interpret_table(void);
+
+			void interpret_threaded(void);
+
+			void invalidate(
+				__in uint16_t address
 				);
 
 			void irq(void);
@@ -127,6 +760,36 @@ namespace mirra {
 
 			uint16_t pop_word(void);
 
+#if TRACE >= TRACE_PROFILE
+			void profile(
+				__in const mirra::instruction_t &entry,
+				__in uint16_t address,
+				__in uint8_t stack_pointer,
+				__in uint64_t cycles
+				);
+
+			void profile_call(
+				__in uint16_t address,
+				__in uint8_t stack_pointer
+				);
+
+			std::string profile_name(
+				__in uint32_t key
+				);
+
+			void profile_return(
+				__in uint8_t stack_pointer
+				);
+
+			void profile_section(
+				__in std::ofstream &file,
+				__in const std::string &title,
+				__in const std::map<uint32_t, mirra::profile_t> &section,
+				__in uint64_t cycles,
+				__in_opt bool bank = false
+				);
+#endif // TRACE >= TRACE_PROFILE
+
 			void push(
 				__in uint8_t value
 				);
@@ -139,6 +802,11 @@ namespace mirra {
 				__in uint16_t address
 				);
 
+			template <mirra::address_t MODE>
+			uint8_t read(
+				__in uint16_t address
+				);
+
 			uint16_t read_word(
 				__in uint16_t address
 				);
@@ -152,6 +820,30 @@ namespace mirra {
 
 			void reset(void);
 
+			void set_sign_zero(
+				__in uint8_t value
+				);
+
+			void step(
+				__in const mirra::instruction_t &entry
+				);
+
+			void step_block(
+				__in const mirra::decode_block_t &block
+				);
+
+			void store_high(
+				__in uint16_t address,
+				__in uint8_t index,
+				__in uint8_t value
+				);
+
+			void write(
+				__in uint16_t address,
+				__in uint8_t value
+				);
+
+			template <mirra::address_t MODE>
 			void write(
 				__in uint16_t address,
 				__in uint8_t value
@@ -162,23 +854,79 @@ namespace mirra {
 				__in uint16_t value
 				);
 
+			static const mirra::instruction_t INSTRUCTION_TABLE[];
+
 			uint8_t m_accumulator;
 
-			uint32_t m_cycles;
+			bool m_boundary;
+
+			std::set<uint16_t> m_breakpoint;
+
+			uint8_t m_carry;
+
+			uint64_t m_cycles;
+
+			uint64_t m_cycles_limit;
+
+			uint64_t m_cycles_target;
+
+			std::vector<mirra::decode_block_t> m_decode;
+
+			uint32_t m_decode_page[MMU_CODE_COUNT];
+
+			uint8_t *m_dynarec;
+
+			uint32_t m_dynarec_offset;
+
+			mirra::engine_t m_engine;
+
+			mirra::cpu_event_t m_event;
 
 			mirra::flag_t m_flag;
 
+			bool m_halted;
+
+			mirra::idle_t m_idle;
+
 			uint8_t m_index_x;
 
 			uint8_t m_index_y;
 
 			bool m_initialized;
 
+			uint32_t m_interrupt;
+
+			bool m_interrupt_delay;
+
+			uint32_t m_interrupt_line;
+
+			mirra::mmu &m_mmu;
+
+			uint8_t m_overflow;
+
+#if TRACE >= TRACE_PROFILE
+			std::map<uint32_t, mirra::profile_t> m_profile;
+
+			std::vector<std::pair<uint32_t, uint8_t>> m_profile_call;
+
+			std::vector<mirra::profile_frame_t> m_profile_frame;
+#endif // TRACE >= TRACE_PROFILE
+
 			uint16_t m_program_counter;
 
+			uint8_t *m_ram;
+
+			uint8_t m_sign;
+
 			uint8_t m_stack_pointer;
 
 			bool m_started;
+
+#if TRACE >= TRACE_INSTRUCTION
+			mirra::trace &m_trace;
+#endif // TRACE >= TRACE_INSTRUCTION
+
+			uint8_t m_zero;
 	};
 }
 
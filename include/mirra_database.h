@@ -0,0 +1,185 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIRRA_DATABASE_H_
+#define MIRRA_DATABASE_H_
+
+#include <vector>
+#include "mirra_singleton.h"
+
+namespace mirra {
+
+	enum {
+		DATABASE_PARAMETER_PATH = 0,
+	};
+
+	#define DATABASE_PARAMETER_MAX DATABASE_PARAMETER_PATH
+
+	#define DATABASE_BLOCK_SIZE 64
+	#define DATABASE_CRC_SLICE 8
+	#define DATABASE_SHA1_LENGTH 20
+	#define DATABASE_SHA1_STATE 5
+	#define DATABASE_VERSION 1
+
+	STRUCT_PACK(database_key_t, {
+		uint32_t crc;
+		uint8_t sha1[DATABASE_SHA1_LENGTH];
+		});
+
+	STRUCT_PACK(database_entry_t, {
+		mirra::database_key_t key;
+		uint16_t mapper;
+		uint8_t submapper;
+		uint8_t mirroring;
+		uint8_t region;
+		uint8_t battery;
+		uint16_t reserved;
+		});
+
+	STRUCT_PACK(database_header_t, {
+		uint32_t magic;
+		uint16_t version;
+		uint16_t size;
+		uint32_t count;
+		uint32_t reserved;
+		});
+
+	typedef struct {
+		uint32_t crc;
+		uint64_t length;
+		uint32_t state[DATABASE_SHA1_STATE];
+		uint8_t block[DATABASE_BLOCK_SIZE];
+	} database_hash_t;
+
+	class database :
+			public mirra::singleton<mirra::database> {
+
+		public:
+
+			~database(void);
+
+			uint32_t checksum(
+				__in const uint8_t *data,
+				__in size_t length
+				);
+
+			bool find(
+				__in const mirra::database_key_t &key,
+				__out mirra::database_entry_t &entry
+				);
+
+			void hash_begin(
+				__out mirra::database_hash_t &hash
+				);
+
+			void hash_end(
+				__in mirra::database_hash_t &hash,
+				__out mirra::database_key_t &key
+				);
+
+			void hash_update(
+				__in mirra::database_hash_t &hash,
+				__in const uint8_t *data,
+				__in size_t length
+				);
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_loaded(void);
+
+			bool is_started(void);
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+			static void write(
+				__in const std::string &path,
+				__in std::vector<mirra::database_entry_t> entry
+				);
+
+		protected:
+
+			friend class mirra::singleton<mirra::database>;
+
+			database(void);
+
+			database(
+				__in const database &other
+				);
+
+			database &operator=(
+				__in const database &other
+				);
+
+			uint32_t crc(
+				__in uint32_t value,
+				__in const uint8_t *data,
+				__in size_t length
+				);
+
+			static bool compare(
+				__in const mirra::database_entry_t &left,
+				__in const mirra::database_entry_t &right
+				);
+
+			void load(
+				__in const std::string &path
+				);
+
+			static void sha1(
+				__inout uint32_t *state,
+				__in const uint8_t *data,
+				__in size_t length
+				);
+
+			void unload(void);
+
+			uint8_t *m_base;
+
+			uint32_t m_count;
+
+			uint32_t m_crc[DATABASE_CRC_SLICE][UINT8_MAX + 1];
+
+			const mirra::database_entry_t *m_entry;
+
+			bool m_initialized;
+
+			size_t m_length;
+
+			std::string m_path;
+
+			bool m_started;
+	};
+}
+
+#endif // MIRRA_DATABASE_H_
@@ -42,6 +42,28 @@ namespace mirra {
 	#define MIRRA_VERSION_REVISION 3
 	#define MIRRA_VERSION_WORKWEEK 1629
 
+#ifdef __GNUC__
+	#define LIKELY(_COND_) __builtin_expect(!!(_COND_), 1)
+	#define UNLIKELY(_COND_) __builtin_expect(!!(_COND_), 0)
+#else
+	#define LIKELY(_COND_) (_COND_)
+	#define UNLIKELY(_COND_) (_COND_)
+#endif // __GNUC__
+
+	typedef enum {
+		STATUS_SUCCESS = 0,
+		STATUS_HALTED,
+		STATUS_INVALID,
+		STATUS_NOT_FOUND,
+		STATUS_STOPPED,
+		STATUS_UNINITIALIZED,
+	} status_t;
+
+	#define STATUS_MAX STATUS_UNINITIALIZED
+
+	#define STATUS_STATE(_INITIALIZED_) \
+		((_INITIALIZED_) ? mirra::STATUS_STOPPED : mirra::STATUS_UNINITIALIZED)
+
 	#define STRING_EMPTY "EMPTY"
 	#define STRING_UNKNOWN "UNKNOWN"
 
@@ -58,6 +80,13 @@ namespace mirra {
 
 	#define STRUCT_PACK(_NAME_, _MEM_) \
 		typedef struct _MEM_ __attribute__((packed)) _NAME_
+
+#ifndef TRACE
+	#define TRACE 0
+#endif // TRACE
+
+	#define TRACE_PROFILE 1
+	#define TRACE_INSTRUCTION 2
 }
 
 #endif // MIRRA_DEFINE_H_
@@ -34,9 +34,13 @@ namespace mirra {
 
 	#define DISPLAY_PARAMETER_MAX DISPLAY_PARAMETER_WIDTH
 
+	#define PIXEL_FILL RGB(0, 0, 0)
+
+	#define PIXEL_INDEX(_X_, _Y_, _W_) (((_Y_) * (_W_)) + (_X_))
+
 	#define RGB(_R_, _G_, _B_) RGBA(_R_, _G_, _B_, UINT8_MAX)
 	#define RGBA(_R_, _G_, _B_, _A_) \
-		((((_B_) & UINT8_MAX) << 24) | (((_G_) & UINT8_MAX) << 16) \
+		(((uint32_t) ((_B_) & UINT8_MAX) << 24) | (((_G_) & UINT8_MAX) << 16) \
 		| (((_R_) & UINT8_MAX) << 8) | (_A_ & UINT8_MAX))
 
 	class display :
@@ -49,7 +53,17 @@ namespace mirra {
 			uint32_t at(
 				__in uint32_t x,
 				__in uint32_t y
-				);
+				)
+			{
+				uint32_t index = PIXEL_INDEX(x, y, m_renderer_width);
+
+				if(UNLIKELY(index >= m_frame.size())) {
+					m_status = (m_started ? STATUS_INVALID : STATUS_STATE(m_initialized));
+					return PIXEL_FILL;
+				}
+
+				return m_frame[index];
+			}
 
 			void clear(void);
 
@@ -61,16 +75,34 @@ namespace mirra {
 
 			bool is_started(void);
 
+			void present(
+				__in const uint8_t *frame,
+				__in uint32_t width,
+				__in uint32_t height,
+				__in const uint32_t *palette
+				);
+
 			void set(
 				__in uint32_t x,
 				__in uint32_t y,
 				__in uint32_t color
-				);
+				)
+			{
+				uint32_t index = PIXEL_INDEX(x, y, m_renderer_width);
+
+				if(UNLIKELY(index >= m_frame.size())) {
+					m_status = (m_started ? STATUS_INVALID : STATUS_STATE(m_initialized));
+				} else {
+					m_frame[index] = color;
+				}
+			}
 
 			void start(
 				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
 				);
 
+			mirra::status_t status(void);
+
 			void stop(void);
 
 			std::string to_string(
@@ -95,6 +127,8 @@ namespace mirra {
 				__in const display &other
 				);
 
+			void render(void);
+
 			std::vector<uint32_t> m_frame;
 
 			bool m_initialized;
@@ -105,6 +139,12 @@ namespace mirra {
 
 			bool m_started;
 
+			mirra::status_t m_status;
+
+			uint32_t m_texture_height;
+
+			uint32_t m_texture_width;
+
 			SDL_Window *m_window;
 
 			SDL_Renderer *m_window_renderer;
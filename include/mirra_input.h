@@ -90,7 +90,7 @@ namespace mirra {
 				__in mirra::joypad_t joypad
 				);
 
-			void process(
+			mirra::status_t process(
 				__in const SDL_KeyboardEvent &event
 				);
 
@@ -100,6 +100,8 @@ namespace mirra {
 				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
 				);
 
+			mirra::status_t status(void);
+
 			void stop(void);
 
 			void strobe(
@@ -142,6 +144,11 @@ namespace mirra {
 				__in mirra::button_t button
 				);
 
+			std::map<SDL_Scancode, bool>::iterator find_state(
+				__in mirra::joypad_t joypad,
+				__in mirra::button_t button
+				);
+
 			std::map<mirra::joypad_t, std::map<mirra::button_t, SDL_Scancode>> m_button;
 
 			std::map<mirra::joypad_t, mirra::button_t> m_button_position;
@@ -152,6 +159,7 @@ namespace mirra {
 
 			bool m_started;
 
+			mirra::status_t m_status;
 	};
 }
 
@@ -0,0 +1,254 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIRRA_MAPPER_H_
+#define MIRRA_MAPPER_H_
+
+#include "mirra_mmu.h"
+#include "mirra_rom.h"
+#include "mirra_scheduler.h"
+
+namespace mirra {
+
+	typedef enum {
+		MAPPER_TYPE_NROM = 0,
+		MAPPER_TYPE_MMC1,
+		MAPPER_TYPE_UXROM,
+		MAPPER_TYPE_CNROM,
+		MAPPER_TYPE_MMC3,
+		MAPPER_TYPE_AXROM,
+	} mapper_type_t;
+
+	#define MAPPER_TYPE_MAX MAPPER_TYPE_AXROM
+
+	#define MAPPER_CHR_BANK_WIDTH 10
+	#define MAPPER_CHR_BANK_SIZE (1 << MAPPER_CHR_BANK_WIDTH)
+	#define MAPPER_CHR_BANK_MASK (MAPPER_CHR_BANK_SIZE - 1)
+	#define MAPPER_CHR_BANK_COUNT 8
+	#define MAPPER_CHR_RAM_SIZE (MAPPER_CHR_BANK_COUNT * MAPPER_CHR_BANK_SIZE)
+
+	#define MAPPER_PRG_ADDRESS 0x8000
+	#define MAPPER_PRG_BANK_WIDTH 13
+	#define MAPPER_PRG_BANK_SIZE (1 << MAPPER_PRG_BANK_WIDTH)
+	#define MAPPER_PRG_BANK_MASK (MAPPER_PRG_BANK_SIZE - 1)
+	#define MAPPER_PRG_BANK_COUNT 4
+
+	#define MAPPER_REGISTER_COUNT 8
+
+	#define MAPPER_CHR_BANK(_ADDR_) (((_ADDR_) >> MAPPER_CHR_BANK_WIDTH) & (MAPPER_CHR_BANK_COUNT - 1))
+	#define MAPPER_PRG_BANK(_ADDR_) (((_ADDR_) >> MAPPER_PRG_BANK_WIDTH) & (MAPPER_PRG_BANK_COUNT - 1))
+
+	class mapper;
+
+	typedef void (mirra::mapper::*mapper_reset_cb)(void);
+
+	typedef void (mirra::mapper::*mapper_write_cb)(
+		__in uint16_t address,
+		__in uint8_t value
+		);
+
+	typedef struct {
+		uint16_t number;
+		mirra::mapper_reset_cb reset;
+		mirra::mapper_write_cb write;
+		const char *name;
+	} mapper_entry_t;
+
+	class mapper :
+			public mirra::singleton<mirra::mapper>,
+			public mirra::bus,
+			public mirra::scheduler_handler {
+
+		public:
+
+			~mapper(void);
+
+			void edge(
+				__in uint64_t cycle
+				);
+
+			void fire(
+				__in mirra::scheduler_event_t event,
+				__in uint64_t cycle
+				);
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_loaded(void)
+			{
+				return (m_entry != nullptr);
+			}
+
+			bool is_started(void);
+
+			mirra::rom_mirroring_t mirroring(void)
+			{
+				return m_mirroring;
+			}
+
+			uint8_t read(
+				__in uint16_t address
+				)
+			{
+				const uint8_t *bank = m_prg[MAPPER_PRG_BANK(address)];
+
+				return (bank ? bank[address & MAPPER_PRG_BANK_MASK] : MMU_PAGE(address));
+			}
+
+			uint8_t read_chr(
+				__in uint16_t address
+				)
+			{
+				return m_chr[MAPPER_CHR_BANK(address)][address & MAPPER_CHR_BANK_MASK];
+			}
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			mirra::mapper_type_t type(void);
+
+			void uninitialize(void);
+
+			void update(void)
+			{
+				return;
+			}
+
+			void write(
+				__in uint16_t address,
+				__in uint8_t value
+				)
+			{
+
+				if(m_entry) {
+					(this->*m_entry->write)(address, value);
+				}
+			}
+
+			void write_chr(
+				__in uint16_t address,
+				__in uint8_t value
+				)
+			{
+
+				if(m_chr_writable) {
+					m_chr[MAPPER_CHR_BANK(address)][address & MAPPER_CHR_BANK_MASK] = value;
+				}
+			}
+
+		protected:
+
+			friend class mirra::singleton<mirra::mapper>;
+
+			mapper(void);
+
+			mapper(
+				__in const mapper &other
+				);
+
+			mapper &operator=(
+				__in const mapper &other
+				);
+
+			void bank_chr(
+				__in uint32_t slot,
+				__in uint32_t count,
+				__in uint32_t bank
+				);
+
+			void bank_prg(
+				__in uint32_t slot,
+				__in uint32_t count,
+				__in uint32_t bank
+				);
+
+			void clear(void);
+
+			void clock(void);
+
+			template <mirra::mapper_type_t TYPE> void reset(void);
+
+			template <mirra::mapper_type_t TYPE> void select(void);
+
+			template <mirra::mapper_type_t TYPE> void write_register(
+				__in uint16_t address,
+				__in uint8_t value
+				);
+
+			static const mirra::mapper_entry_t MAPPER_TABLE[MAPPER_TYPE_MAX + 1];
+
+			uint8_t *m_chr[MAPPER_CHR_BANK_COUNT];
+
+			uint8_t *m_chr_base;
+
+			std::vector<uint8_t> m_chr_ram;
+
+			uint32_t m_chr_size;
+
+			bool m_chr_writable;
+
+			mirra::cpu &m_cpu;
+
+			const mirra::mapper_entry_t *m_entry;
+
+			bool m_initialized;
+
+			uint8_t m_irq_counter;
+
+			bool m_irq_enable;
+
+			uint8_t m_irq_latch;
+
+			bool m_irq_reload;
+
+			mirra::rom_mirroring_t m_mirroring;
+
+			mirra::mmu &m_mmu;
+
+			const uint8_t *m_prg[MAPPER_PRG_BANK_COUNT];
+
+			uint32_t m_prg_size;
+
+			uint8_t m_register[MAPPER_REGISTER_COUNT];
+
+			mirra::rom &m_rom;
+
+			mirra::scheduler &m_scheduler;
+
+			uint8_t m_select;
+
+			uint8_t m_shift;
+
+			bool m_started;
+	};
+}
+
+#endif // MIRRA_MAPPER_H_
@@ -0,0 +1,254 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_MMU_H_
+#define MIRRA_MMU_H_
+
+#include <vector>
+#include "mirra_bus.h"
+#include "mirra_singleton.h"
+
+namespace mirra {
+
+	#define MMU_PAGE_WIDTH CHAR_BIT
+	#define MMU_PAGE_SIZE (1 << MMU_PAGE_WIDTH)
+	#define MMU_PAGE_MASK (MMU_PAGE_SIZE - 1)
+	#define MMU_PAGE_COUNT ((BUS_WORD_MAX + 1) / MMU_PAGE_SIZE)
+
+	#define MMU_PAGE(_ADDR_) ((_ADDR_) >> MMU_PAGE_WIDTH)
+	#define MMU_PAGE_OFFSET(_ADDR_) ((_ADDR_) & MMU_PAGE_MASK)
+
+	#define MMU_PORT_ADDRESS 0x4000
+	#define MMU_PORT_COUNT 0x20
+
+	#define MMU_RAM_ADDRESS 0x0000
+	#define MMU_RAM_LENGTH 0x2000
+	#define MMU_RAM_SIZE 0x0800
+
+	#define MMU_SRAM_ADDRESS 0x6000
+	#define MMU_SRAM_SIZE 0x2000
+
+	#define MMU_CODE_WIDTH 5
+	#define MMU_CODE_MASK ((1 << MMU_CODE_WIDTH) - 1)
+	#define MMU_CODE_COUNT (MMU_PAGE_COUNT >> MMU_CODE_WIDTH)
+
+	#define MMU_CODE_CHECK(_CODE_, _PAGE_) \
+		((_CODE_)[(_PAGE_) >> MMU_CODE_WIDTH] & (1U << ((_PAGE_) & MMU_CODE_MASK)))
+
+	typedef struct {
+		uint8_t *read;
+		uint8_t *write;
+		mirra::bus *handler;
+	} mmu_page_t;
+
+	class mmu_handler {
+
+		public:
+
+			virtual void invalidate(
+				__in uint16_t address
+				) = 0;
+
+	};
+
+	class mmu_port :
+			public mirra::bus {
+
+		public:
+
+			mmu_port(void);
+
+			void clear(void);
+
+			void map(
+				__in uint16_t address,
+				__in mirra::bus *handler
+				);
+
+			uint8_t read(
+				__in uint16_t address
+				);
+
+			void update(void);
+
+			void write(
+				__in uint16_t address,
+				__in uint8_t value
+				);
+
+		protected:
+
+			mirra::bus *m_handler[MMU_PORT_COUNT];
+	};
+
+	class mmu :
+			public mirra::singleton<mirra::mmu> {
+
+		public:
+
+			~mmu(void);
+
+			void attach(
+				__in mirra::mmu_handler *handler
+				);
+
+			uint16_t bank(
+				__in uint16_t address
+				)
+			{
+				return m_bank[MMU_PAGE(address)];
+			}
+
+			void code(
+				__in uint16_t address
+				);
+
+			void detach(void);
+
+			const uint32_t &generation(void)
+			{
+				return m_generation;
+			}
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_started(void);
+
+			void map(
+				__in uint16_t address,
+				__in uint32_t length,
+				__in uint8_t *read,
+				__in uint8_t *write,
+				__in_opt mirra::bus *handler = nullptr,
+				__in_opt uint16_t bank = 0
+				);
+
+			void map_port(
+				__in uint16_t address,
+				__in mirra::bus *handler
+				);
+
+			const mirra::mmu_page_t &page(
+				__in uint16_t address
+				)
+			{
+				return m_page[MMU_PAGE(address)];
+			}
+
+			uint8_t *ram(void);
+
+			uint8_t read(
+				__in uint16_t address
+				)
+			{
+				const mirra::mmu_page_t &page = m_page[MMU_PAGE(address)];
+
+				if(page.read) {
+					return page.read[MMU_PAGE_OFFSET(address)];
+				}
+
+				return (page.handler ? page.handler->read(address) : MMU_PAGE(address));
+			}
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+			void unmap(
+				__in uint16_t address,
+				__in uint32_t length
+				);
+
+			void unmap_port(
+				__in uint16_t address
+				);
+
+			void write(
+				__in uint16_t address,
+				__in uint8_t value
+				)
+			{
+				const mirra::mmu_page_t &page = m_page[MMU_PAGE(address)];
+
+				if(page.write) {
+					page.write[MMU_PAGE_OFFSET(address)] = value;
+
+					if(MMU_CODE_CHECK(m_code, MMU_PAGE(address))) {
+						invalidate(address);
+					}
+				} else if(page.handler) {
+					page.handler->write(address, value);
+				}
+			}
+
+		protected:
+
+			friend class mirra::singleton<mirra::mmu>;
+
+			mmu(void);
+
+			mmu(
+				__in const mmu &other
+				);
+
+			mmu &operator=(
+				__in const mmu &other
+				);
+
+			void clear(void);
+
+			void invalidate(
+				__in uint16_t address
+				);
+
+			uint16_t m_bank[MMU_PAGE_COUNT];
+
+			uint32_t m_code[MMU_CODE_COUNT];
+
+			uint32_t m_generation;
+
+			mirra::mmu_handler *m_handler;
+
+			bool m_initialized;
+
+			mirra::mmu_page_t m_page[MMU_PAGE_COUNT];
+
+			mirra::mmu_port m_port;
+
+			std::vector<uint8_t> m_ram;
+
+			std::vector<uint8_t> m_sram;
+
+			bool m_started;
+	};
+}
+
+#endif // MIRRA_MMU_H_
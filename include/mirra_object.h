@@ -29,6 +29,7 @@ namespace mirra {
 		OBJECT_APU = 0,
 		OBJECT_BLOCK,
 		OBJECT_CPU,
+		OBJECT_DATABASE,
 		OBJECT_DISPLAY,
 		OBJECT_INPUT,
 		OBJECT_MAPPER,
@@ -36,9 +37,11 @@ namespace mirra {
 		OBJECT_PPU,
 		OBJECT_ROM,
 		OBJECT_RUNTIME,
+		OBJECT_SCHEDULER,
+		OBJECT_TRACE,
 	} object_t;
 
-	#define OBJECT_MAX OBJECT_RUNTIME
+	#define OBJECT_MAX OBJECT_TRACE
 
 	#define OBJECT_SUBTYPE_UNDEFINED SCALAR_INVALID(uint32_t)
 
@@ -0,0 +1,205 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_PPU_H_
+#define MIRRA_PPU_H_
+
+#include "mirra_display.h"
+#include "mirra_mapper.h"
+
+namespace mirra {
+
+	#define PPU_HEIGHT 240
+	#define PPU_WIDTH 256
+
+	#define PPU_OAM_SIZE 0x100
+	#define PPU_PALETTE_SIZE 0x20
+	#define PPU_VRAM_SIZE 0x1000
+
+	typedef enum {
+		PPU_REGISTER_CONTROL = 0,
+		PPU_REGISTER_MASK,
+		PPU_REGISTER_STATUS,
+		PPU_REGISTER_OAM_ADDRESS,
+		PPU_REGISTER_OAM_DATA,
+		PPU_REGISTER_SCROLL,
+		PPU_REGISTER_ADDRESS,
+		PPU_REGISTER_DATA,
+	} ppu_register_t;
+
+	#define PPU_REGISTER_MAX PPU_REGISTER_DATA
+
+	class ppu :
+			public mirra::singleton<mirra::ppu>,
+			public mirra::bus,
+			public mirra::scheduler_handler {
+
+		public:
+
+			~ppu(void);
+
+			void fire(
+				__in mirra::scheduler_event_t event,
+				__in uint64_t cycle
+				);
+
+			const uint8_t *frame(void)
+			{
+				return m_frame;
+			}
+
+			uint64_t frames(void)
+			{
+				return m_frames;
+			}
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_started(void);
+
+			uint8_t read(
+				__in uint16_t address
+				);
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+			void update(void)
+			{
+				return;
+			}
+
+			void write(
+				__in uint16_t address,
+				__in uint8_t value
+				);
+
+		protected:
+
+			friend class mirra::singleton<mirra::ppu>;
+
+			ppu(void);
+
+			ppu(
+				__in const ppu &other
+				);
+
+			ppu &operator=(
+				__in const ppu &other
+				);
+
+			void clear(void);
+
+			uint8_t &nametable(
+				__in uint16_t address
+				);
+
+			uint8_t &palette(
+				__in uint16_t address
+				);
+
+			void predict(
+				__in uint64_t cycle
+				);
+
+			uint8_t read_data(
+				__in uint16_t address
+				);
+
+			void render(
+				__in uint32_t line
+				);
+
+			void synchronize(
+				__in uint64_t cycle
+				);
+
+			void write_data(
+				__in uint16_t address,
+				__in uint8_t value
+				);
+
+			uint16_t m_address;
+
+			uint16_t m_address_temporary;
+
+			uint8_t m_buffer;
+
+			uint8_t m_control;
+
+			mirra::cpu &m_cpu;
+
+			uint64_t m_cycle;
+
+			mirra::display &m_display;
+
+			uint64_t m_edge;
+
+			uint8_t m_fine;
+
+			uint8_t m_frame[PPU_WIDTH * PPU_HEIGHT];
+
+			uint64_t m_frames;
+
+			bool m_initialized;
+
+			uint8_t m_latch;
+
+			uint32_t m_line;
+
+			mirra::mapper &m_mapper;
+
+			uint8_t m_mask;
+
+			mirra::mmu &m_mmu;
+
+			uint8_t m_oam[PPU_OAM_SIZE];
+
+			uint8_t m_oam_address;
+
+			uint8_t m_palette[PPU_PALETTE_SIZE];
+
+			mirra::scheduler &m_scheduler;
+
+			bool m_skip;
+
+			bool m_started;
+
+			uint8_t m_status;
+
+			bool m_toggle;
+
+			uint8_t m_vram[PPU_VRAM_SIZE];
+	};
+}
+
+#endif // MIRRA_PPU_H_
@@ -0,0 +1,340 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIRRA_ROM_H_
+#define MIRRA_ROM_H_
+
+#include <vector>
+#include "mirra_database.h"
+
+namespace mirra {
+
+	enum {
+		ROM_PARAMETER_CACHE = 0,
+		ROM_PARAMETER_PATCH,
+		ROM_PARAMETER_PATH,
+	};
+
+	#define ROM_PARAMETER_MAX ROM_PARAMETER_PATH
+
+	typedef enum {
+		ROM_FORMAT_INES = 0,
+		ROM_FORMAT_NES2,
+	} rom_format_t;
+
+	#define ROM_FORMAT_MAX ROM_FORMAT_NES2
+
+	typedef enum {
+		ROM_MIRRORING_HORIZONTAL = 0,
+		ROM_MIRRORING_VERTICAL,
+		ROM_MIRRORING_FOUR_SCREEN,
+		ROM_MIRRORING_SINGLE_LOWER,
+		ROM_MIRRORING_SINGLE_UPPER,
+	} rom_mirroring_t;
+
+	#define ROM_MIRRORING_MAX ROM_MIRRORING_SINGLE_UPPER
+
+	typedef enum {
+		ROM_REGION_NTSC = 0,
+		ROM_REGION_PAL,
+		ROM_REGION_MULTIPLE,
+		ROM_REGION_DENDY,
+	} rom_region_t;
+
+	#define ROM_REGION_MAX ROM_REGION_DENDY
+
+	#define ROM_BANK_CHR_SIZE 0x2000
+	#define ROM_BANK_PRG_SIZE 0x4000
+
+	#define ROM_TRAINER_SIZE 0x0200
+
+	STRUCT_PACK(rom_header_t, {
+		uint8_t magic[4];
+		uint8_t prg;
+		uint8_t chr;
+		uint8_t flag_6;
+		uint8_t flag_7;
+		uint8_t flag_8;
+		uint8_t flag_9;
+		uint8_t flag_10;
+		uint8_t flag_11;
+		uint8_t flag_12;
+		uint8_t flag_13;
+		uint8_t flag_14;
+		uint8_t flag_15;
+		});
+
+	#define ROM_HUFFMAN_BITS 15
+	#define ROM_HUFFMAN_FAST 9
+	#define ROM_HUFFMAN_SYMBOLS 288
+
+	typedef struct {
+		uint16_t count[ROM_HUFFMAN_BITS + 1];
+		uint16_t fast[1 << ROM_HUFFMAN_FAST];
+		uint16_t symbol[ROM_HUFFMAN_SYMBOLS];
+	} rom_huffman_t;
+
+	typedef struct {
+		const uint8_t *data;
+		size_t length;
+		size_t position;
+		uint64_t buffer;
+		uint32_t count;
+		uint8_t *target;
+		size_t size;
+		size_t output;
+	} rom_inflate_t;
+
+	class rom :
+			public mirra::singleton<mirra::rom> {
+
+		public:
+
+			~rom(void);
+
+			bool battery(void)
+			{
+				return m_battery;
+			}
+
+			const uint8_t *chr(void)
+			{
+				return m_chr;
+			}
+
+			uint32_t chr_size(void)
+			{
+				return m_chr_size;
+			}
+
+			mirra::rom_format_t format(void)
+			{
+				return m_format;
+			}
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_loaded(void);
+
+			bool is_started(void);
+
+			uint16_t mapper(void)
+			{
+				return m_mapper;
+			}
+
+			mirra::rom_mirroring_t mirroring(void)
+			{
+				return m_mirroring;
+			}
+
+			const uint8_t *prg(void)
+			{
+				return m_prg;
+			}
+
+			uint32_t prg_size(void)
+			{
+				return m_prg_size;
+			}
+
+			mirra::rom_region_t region(void)
+			{
+				return m_region;
+			}
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			uint8_t submapper(void)
+			{
+				return m_submapper;
+			}
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			const uint8_t *trainer(void)
+			{
+				return m_trainer;
+			}
+
+			void uninitialize(void);
+
+		protected:
+
+			friend class mirra::singleton<mirra::rom>;
+
+			rom(void);
+
+			rom(
+				__in const rom &other
+				);
+
+			rom &operator=(
+				__in const rom &other
+				);
+
+			bool apply(
+				__in const std::vector<uint8_t> &data,
+				__in uint8_t *target,
+				__in size_t reserve,
+				__inout size_t &length,
+				__in_opt const uint8_t *source = nullptr
+				);
+
+			void clear(void);
+
+			void correct(void);
+
+			int extract(
+				__in int handle,
+				__in const std::string &path,
+				__inout size_t &length
+				);
+
+			static bool inflate(
+				__in const uint8_t *data,
+				__in size_t length,
+				__in uint8_t *target,
+				__in size_t size
+				);
+
+			static bool inflate_bits(
+				__inout mirra::rom_inflate_t &state,
+				__in uint32_t count,
+				__out uint32_t &value
+				);
+
+			static bool inflate_block(
+				__inout mirra::rom_inflate_t &state,
+				__in const mirra::rom_huffman_t &literal,
+				__in const mirra::rom_huffman_t &distance
+				);
+
+			static bool inflate_build(
+				__out mirra::rom_huffman_t &huffman,
+				__in const uint8_t *length,
+				__in uint32_t count
+				);
+
+			static bool inflate_decode(
+				__inout mirra::rom_inflate_t &state,
+				__in const mirra::rom_huffman_t &huffman,
+				__out uint32_t &symbol
+				);
+
+			static bool inflate_dynamic(
+				__inout mirra::rom_inflate_t &state,
+				__out mirra::rom_huffman_t &literal,
+				__out mirra::rom_huffman_t &distance
+				);
+
+			void load(
+				__in const std::string &path,
+				__in const std::vector<std::string> &patch
+				);
+
+			bool parse(
+				__in const mirra::rom_header_t &header
+				);
+
+			bool patch_bps(
+				__in const std::vector<uint8_t> &data,
+				__in uint8_t *target,
+				__in size_t reserve,
+				__inout size_t &length,
+				__in_opt const uint8_t *source = nullptr
+				);
+
+			static bool patch_decode(
+				__in const std::vector<uint8_t> &data,
+				__inout size_t &position,
+				__in size_t end,
+				__out uint64_t &value
+				);
+
+			bool patch_ips(
+				__in const std::vector<uint8_t> &data,
+				__in uint8_t *target,
+				__in size_t reserve,
+				__inout size_t &length
+				);
+
+			bool patch_ups(
+				__in const std::vector<uint8_t> &data,
+				__in uint8_t *target,
+				__in size_t reserve,
+				__inout size_t &length
+				);
+
+			void unload(void);
+
+			bool m_archive;
+
+			uint8_t *m_base;
+
+			bool m_battery;
+
+			std::string m_cache;
+
+			const uint8_t *m_chr;
+
+			uint32_t m_chr_size;
+
+			bool m_corrected;
+
+			mirra::rom_format_t m_format;
+
+			bool m_initialized;
+
+			size_t m_length;
+
+			uint16_t m_mapper;
+
+			mirra::rom_mirroring_t m_mirroring;
+
+			uint32_t m_patch;
+
+			std::string m_path;
+
+			const uint8_t *m_prg;
+
+			uint32_t m_prg_size;
+
+			mirra::rom_region_t m_region;
+
+			bool m_started;
+
+			uint8_t m_submapper;
+
+			const uint8_t *m_trainer;
+	};
+}
+
+#endif // MIRRA_ROM_H_
@@ -0,0 +1,155 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_SCHEDULER_H_
+#define MIRRA_SCHEDULER_H_
+
+#include "mirra_cpu.h"
+
+namespace mirra {
+
+	#define SCHEDULER_CPU_DIVIDER 12
+	#define SCHEDULER_PPU_DIVIDER 4
+
+	#define SCHEDULER_CYCLE_NEVER UINT64_MAX
+	#define SCHEDULER_FRAME_CYCLES 357366
+
+	#define SCHEDULER_CPU_CYCLES(_CYCLES_) \
+		(((_CYCLES_) + (SCHEDULER_CPU_DIVIDER - 1)) / SCHEDULER_CPU_DIVIDER)
+
+	typedef enum {
+		SCHEDULER_EVENT_APU = 0,
+		SCHEDULER_EVENT_MAPPER,
+		SCHEDULER_EVENT_PPU,
+	} scheduler_event_t;
+
+	#define SCHEDULER_EVENT_MAX SCHEDULER_EVENT_PPU
+
+	class scheduler_handler {
+
+		public:
+
+			virtual void fire(
+				__in mirra::scheduler_event_t event,
+				__in uint64_t cycle
+				) = 0;
+
+	};
+
+	typedef struct {
+		uint64_t cycle;
+		mirra::scheduler_handler *handler;
+	} scheduler_entry_t;
+
+	class scheduler :
+			public mirra::singleton<mirra::scheduler> {
+
+		public:
+
+			~scheduler(void);
+
+			void attach(
+				__in mirra::scheduler_event_t event,
+				__in mirra::scheduler_handler *handler
+				);
+
+			void cancel(
+				__in mirra::scheduler_event_t event
+				);
+
+			uint64_t cycle(void)
+			{
+				return (m_cpu.cycles() * SCHEDULER_CPU_DIVIDER);
+			}
+
+			void detach(
+				__in mirra::scheduler_event_t event
+				);
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_started(void);
+
+			uint64_t next(void)
+			{
+				return m_next;
+			}
+
+			mirra::cpu_event_t run(
+				__in uint64_t cycles
+				);
+
+			mirra::cpu_event_t run_until(
+				__in mirra::cpu_event_t event
+				);
+
+			void schedule(
+				__in mirra::scheduler_event_t event,
+				__in uint64_t cycle
+				);
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+		protected:
+
+			friend class mirra::singleton<mirra::scheduler>;
+
+			scheduler(void);
+
+			scheduler(
+				__in const scheduler &other
+				);
+
+			scheduler &operator=(
+				__in const scheduler &other
+				);
+
+			void clear(void);
+
+			void dispatch(void);
+
+			void update(void);
+
+			mirra::cpu &m_cpu;
+
+			mirra::scheduler_entry_t m_entry[SCHEDULER_EVENT_MAX + 1];
+
+			bool m_initialized;
+
+			uint64_t m_next;
+
+			bool m_started;
+	};
+}
+
+#endif // MIRRA_SCHEDULER_H_
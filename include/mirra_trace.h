@@ -0,0 +1,147 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_TRACE_H_
+#define MIRRA_TRACE_H_
+
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "mirra_singleton.h"
+
+namespace mirra {
+
+	enum {
+		TRACE_PARAMETER_FORMAT = 0,
+		TRACE_PARAMETER_PATH,
+	};
+
+	#define TRACE_PARAMETER_MAX TRACE_PARAMETER_PATH
+
+	typedef enum {
+		TRACE_FORMAT_TEXT = 0,
+		TRACE_FORMAT_BINARY,
+	} trace_format_t;
+
+	#define TRACE_FORMAT_MAX TRACE_FORMAT_BINARY
+
+	#define TRACE_RING_SIZE 0x100000
+	#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+	STRUCT_PACK(trace_record_t, {
+		uint64_t cycles;
+		uint16_t program_counter;
+		uint16_t operand;
+		uint8_t opcode;
+		uint8_t accumulator;
+		uint8_t index_x;
+		uint8_t index_y;
+		uint8_t flag;
+		uint8_t stack_pointer;
+		});
+
+	class trace :
+			public mirra::singleton<mirra::trace> {
+
+		public:
+
+			~trace(void);
+
+			void initialize(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			bool is_initialized(void);
+
+			bool is_started(void);
+
+			void push(
+				__in const mirra::trace_record_t &record
+				)
+			{
+				uint32_t head;
+
+				if(m_started) {
+					head = m_head.load(std::memory_order_relaxed);
+					m_ring[head & TRACE_RING_MASK] = record;
+					m_head.store(head + 1, std::memory_order_release);
+				}
+			}
+
+			void start(
+				__in_opt const mirra::parameter_t &parameter = mirra::parameter_t()
+				);
+
+			void stop(void);
+
+			std::string to_string(
+				__in_opt bool verbose = false
+				);
+
+			void uninitialize(void);
+
+		protected:
+
+			friend class mirra::singleton<mirra::trace>;
+
+			trace(void);
+
+			trace(
+				__in const trace &other
+				);
+
+			trace &operator=(
+				__in const trace &other
+				);
+
+			void output(
+				__in const mirra::trace_record_t *record,
+				__in uint32_t count
+				);
+
+			static void run(
+				__in mirra::trace &context
+				);
+
+			std::atomic<bool> m_active;
+
+			std::vector<mirra::trace_record_t> m_batch;
+
+			std::ofstream m_file;
+
+			mirra::trace_format_t m_format;
+
+			std::atomic<uint32_t> m_head;
+
+			bool m_initialized;
+
+			std::atomic<uint64_t> m_lost;
+
+			std::vector<mirra::trace_record_t> m_ring;
+
+			bool m_started;
+
+			std::atomic<uint32_t> m_tail;
+
+			std::thread m_thread;
+	};
+}
+
+#endif // MIRRA_TRACE_H_
@@ -17,24 +17,104 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include "../include/mirra_cpu.h"
 #include "mirra_cpu_type.h"
 
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__unix__) && (TRACE < TRACE_PROFILE)
+#define DYNAREC_SUPPORTED
+#include <sys/mman.h>
+#endif // __x86_64__ && __GNUC__ && __unix__ && TRACE < TRACE_PROFILE
+
 namespace mirra {
 
 	#define INTERRUPT_IRQ 0xfffe
 	#define INTERRUPT_NMI 0xfffa
 	#define INTERRUPT_RESET 0xfffc
 
+	#define INTERRUPT_CYCLES 7
+	#define INTERRUPT_IRQ_MASK \
+		((1 << INTERRUPT_LINE_APU) | (1 << INTERRUPT_LINE_DMC) | (1 << INTERRUPT_LINE_MAPPER))
+
+#if TRACE >= TRACE_PROFILE
+	#define PROFILE_KEY(_BANK_, _ADDR_) (((_BANK_) << BUS_WORD_WIDTH) | (_ADDR_))
+	#define PROFILE_KEY_ADDRESS(_KEY_) ((_KEY_) & BUS_WORD_MAX)
+	#define PROFILE_KEY_BANK(_KEY_) ((_KEY_) >> BUS_WORD_WIDTH)
+	#define PROFILE_KEY_ROOT SCALAR_INVALID(uint32_t)
+	#define PROFILE_ROOT "main"
+#endif // TRACE >= TRACE_PROFILE
+
 	#define REGISTER_FLAG_DEFAULT {0, 0, 1, 0, 1, 1, 0, 0}
 	#define REGISTER_ACCUMULATOR_DEFAULT 0
+	#define REGISTER_CARRY_DEFAULT 0
 	#define REGISTER_INDEX_X_DEFAULT 0
 	#define REGISTER_INDEX_Y_DEFAULT 0
+	#define REGISTER_OVERFLOW_DEFAULT 0
 	#define REGISTER_PROGRAM_COUNTER_DEFAULT 0
+	#define REGISTER_SIGN_DEFAULT 0
 	#define REGISTER_STACK_POINTER_DEFAULT UINT8_MAX
+	#define REGISTER_ZERO_DEFAULT 1
 
 	#define STACK_BASE (UINT8_MAX + 1)
 
+	#define UNSTABLE_MAGIC 0xee
+
+	#define ZERO_PAGE_MODE(_MODE_) ((_MODE_) >= ADDRESS_ZERO_PAGE)
+
+	#define IDLE_LENGTH_MAX 0x10
+	#define IDLE_PURE(_ENTRY_, _HANDLER_) \
+		(((_ENTRY_)->handler == INSTRUCTION_HANDLER(_HANDLER_, ABSOLUTE)) \
+		|| ((_ENTRY_)->handler == INSTRUCTION_HANDLER(_HANDLER_, IMMEDIATE)) \
+		|| ((_ENTRY_)->handler == INSTRUCTION_HANDLER(_HANDLER_, ZERO_PAGE)))
+	#define IDLE_PPU_STATUS 0x2002
+	#define IDLE_PPU_STATUS_MASK 0xe007
+
+	#define DYNAREC_ALIGN 0xf
+	#define DYNAREC_BLOCK_SIZE 0x1000
+	#define DYNAREC_ENTER 0
+	#define DYNAREC_EXIT 0x10
+	#define DYNAREC_START 0x20
+	#define DYNAREC_SIZE 0x400000
+	#define DYNAREC_THRESHOLD 8
+
+	#define DYNAREC_EMIT(_CURSOR_, _TYPE_, _VALUE_) { \
+		_TYPE_ _value_ = (_TYPE_) (_VALUE_); \
+		std::memcpy((_CURSOR_), &_value_, sizeof(_TYPE_)); \
+		(_CURSOR_) += sizeof(_TYPE_); \
+		}
+	#define DYNAREC_EMIT_8(_CURSOR_, _VALUE_) DYNAREC_EMIT(_CURSOR_, uint8_t, _VALUE_)
+	#define DYNAREC_EMIT_16(_CURSOR_, _VALUE_) DYNAREC_EMIT(_CURSOR_, uint16_t, _VALUE_)
+	#define DYNAREC_EMIT_32(_CURSOR_, _VALUE_) DYNAREC_EMIT(_CURSOR_, uint32_t, _VALUE_)
+	#define DYNAREC_EMIT_64(_CURSOR_, _VALUE_) DYNAREC_EMIT(_CURSOR_, uint64_t, _VALUE_)
+
+	#define DYNAREC_OFFSET(_MEMBER_) \
+		((int32_t) ((uintptr_t) &(_MEMBER_) - (uintptr_t) this))
+
+	#define DYNAREC_PATCH(_CURSOR_, _TARGET_) { \
+		int32_t _offset_ = (int32_t) ((_TARGET_) - ((_CURSOR_) + sizeof(int32_t))); \
+		std::memcpy((_CURSOR_), &_offset_, sizeof(int32_t)); \
+		}
+
+	#define DYNAREC_TRANSPARENT_MODE(_MODE_) \
+		(ZERO_PAGE_MODE(_MODE_) || ((_MODE_) == ADDRESS_ACCUMULATOR) || ((_MODE_) == ADDRESS_IMMEDIATE) \
+		|| ((_MODE_) == ADDRESS_IMPLIED) || ((_MODE_) == ADDRESS_RELATIVE))
+
+	typedef void (*dynarec_cb)(
+		__in mirra::cpu *instance,
+		__in uint8_t *code
+		);
+
+	#define DECODE_TERMINAL(_ENTRY_) \
+		(((_ENTRY_).mode == ADDRESS_RELATIVE) \
+		|| ((_ENTRY_).handler == INSTRUCTION_HANDLER(brk, IMPLIED)) \
+		|| ((_ENTRY_).handler == INSTRUCTION_HANDLER(jmp, ABSOLUTE)) \
+		|| ((_ENTRY_).handler == INSTRUCTION_HANDLER(jmp, INDIRECT)) \
+		|| ((_ENTRY_).handler == INSTRUCTION_HANDLER(jsr, ABSOLUTE)) \
+		|| ((_ENTRY_).handler == INSTRUCTION_HANDLER(rti, IMPLIED)) \
+		|| ((_ENTRY_).handler == INSTRUCTION_HANDLER(rts, IMPLIED)))
+
 	#define _BIT_OPERATION(_OP_, _VAL_, _BIT_) ((_VAL_)_OP_(1 << (_BIT_)))
 	#define BIT_CHECK(_VAL_, _BIT_) _BIT_OPERATION(&, _VAL_, _BIT_)
 	#define BIT_CLEAR(_VAL_, _BIT_)	_BIT_OPERATION(&=~, _VAL_, _BIT_)
@@ -52,7 +132,7 @@ namespace mirra {
 		OPCODE_ADC_IMMEDIATE = 0x69,
 		OPCODE_ADC_INDIRECT_X = 0x61,
 		OPCODE_ADC_INDIRECT_Y = 0x71,
-		OPCDOE_ADC_ZERO_PAGE = 0x65,
+		OPCODE_ADC_ZERO_PAGE = 0x65,
 		OPCODE_ADC_ZERO_PAGE_X = 0x75,
 
 		OPCODE_AND_ABSOLUTE = 0x2d,
@@ -74,6 +154,7 @@ namespace mirra {
 		OPCODE_BIT_ZERO_PAGE = 0x24,
 
 		OPCODE_BCC_RELATIVE = 0x90,
+		OPCODE_BCS_RELATIVE = 0xb0,
 		OPCODE_BEQ_RELATIVE = 0xf0,
 		OPCODE_BMI_RELATIVE = 0x30,
 		OPCODE_BNE_RELATIVE = 0xd0,
@@ -226,6 +307,133 @@ namespace mirra {
 		OPCODE_STY_ABSOLUTE = 0x8c,
 		OPCODE_STY_ZERO_PAGE = 0x84,
 		OPCODE_STY_ZERO_PAGE_X = 0x94,
+
+		OPCODE_ALR_IMMEDIATE = 0x4b,
+
+		OPCODE_ANC_IMMEDIATE_0B = 0xb,
+		OPCODE_ANC_IMMEDIATE_2B = 0x2b,
+
+		OPCODE_ANE_IMMEDIATE = 0x8b,
+
+		OPCODE_ARR_IMMEDIATE = 0x6b,
+
+		OPCODE_DCP_ABSOLUTE = 0xcf,
+		OPCODE_DCP_ABSOLUTE_X = 0xdf,
+		OPCODE_DCP_ABSOLUTE_Y = 0xdb,
+		OPCODE_DCP_INDIRECT_X = 0xc3,
+		OPCODE_DCP_INDIRECT_Y = 0xd3,
+		OPCODE_DCP_ZERO_PAGE = 0xc7,
+		OPCODE_DCP_ZERO_PAGE_X = 0xd7,
+
+		OPCODE_ISC_ABSOLUTE = 0xef,
+		OPCODE_ISC_ABSOLUTE_X = 0xff,
+		OPCODE_ISC_ABSOLUTE_Y = 0xfb,
+		OPCODE_ISC_INDIRECT_X = 0xe3,
+		OPCODE_ISC_INDIRECT_Y = 0xf3,
+		OPCODE_ISC_ZERO_PAGE = 0xe7,
+		OPCODE_ISC_ZERO_PAGE_X = 0xf7,
+
+		OPCODE_JAM_02 = 0x2,
+		OPCODE_JAM_12 = 0x12,
+		OPCODE_JAM_22 = 0x22,
+		OPCODE_JAM_32 = 0x32,
+		OPCODE_JAM_42 = 0x42,
+		OPCODE_JAM_52 = 0x52,
+		OPCODE_JAM_62 = 0x62,
+		OPCODE_JAM_72 = 0x72,
+		OPCODE_JAM_92 = 0x92,
+		OPCODE_JAM_B2 = 0xb2,
+		OPCODE_JAM_D2 = 0xd2,
+		OPCODE_JAM_F2 = 0xf2,
+
+		OPCODE_LAS_ABSOLUTE_Y = 0xbb,
+
+		OPCODE_LAX_ABSOLUTE = 0xaf,
+		OPCODE_LAX_ABSOLUTE_Y = 0xbf,
+		OPCODE_LAX_INDIRECT_X = 0xa3,
+		OPCODE_LAX_INDIRECT_Y = 0xb3,
+		OPCODE_LAX_ZERO_PAGE = 0xa7,
+		OPCODE_LAX_ZERO_PAGE_Y = 0xb7,
+
+		OPCODE_LXA_IMMEDIATE = 0xab,
+
+		OPCODE_NOP_ABSOLUTE_0C = 0xc,
+		OPCODE_NOP_ABSOLUTE_X_1C = 0x1c,
+		OPCODE_NOP_ABSOLUTE_X_3C = 0x3c,
+		OPCODE_NOP_ABSOLUTE_X_5C = 0x5c,
+		OPCODE_NOP_ABSOLUTE_X_7C = 0x7c,
+		OPCODE_NOP_ABSOLUTE_X_DC = 0xdc,
+		OPCODE_NOP_ABSOLUTE_X_FC = 0xfc,
+		OPCODE_NOP_IMMEDIATE_80 = 0x80,
+		OPCODE_NOP_IMMEDIATE_82 = 0x82,
+		OPCODE_NOP_IMMEDIATE_89 = 0x89,
+		OPCODE_NOP_IMMEDIATE_C2 = 0xc2,
+		OPCODE_NOP_IMMEDIATE_E2 = 0xe2,
+		OPCODE_NOP_IMPLIED_1A = 0x1a,
+		OPCODE_NOP_IMPLIED_3A = 0x3a,
+		OPCODE_NOP_IMPLIED_5A = 0x5a,
+		OPCODE_NOP_IMPLIED_7A = 0x7a,
+		OPCODE_NOP_IMPLIED_DA = 0xda,
+		OPCODE_NOP_IMPLIED_FA = 0xfa,
+		OPCODE_NOP_ZERO_PAGE_04 = 0x4,
+		OPCODE_NOP_ZERO_PAGE_44 = 0x44,
+		OPCODE_NOP_ZERO_PAGE_64 = 0x64,
+		OPCODE_NOP_ZERO_PAGE_X_14 = 0x14,
+		OPCODE_NOP_ZERO_PAGE_X_34 = 0x34,
+		OPCODE_NOP_ZERO_PAGE_X_54 = 0x54,
+		OPCODE_NOP_ZERO_PAGE_X_74 = 0x74,
+		OPCODE_NOP_ZERO_PAGE_X_D4 = 0xd4,
+		OPCODE_NOP_ZERO_PAGE_X_F4 = 0xf4,
+
+		OPCODE_RLA_ABSOLUTE = 0x2f,
+		OPCODE_RLA_ABSOLUTE_X = 0x3f,
+		OPCODE_RLA_ABSOLUTE_Y = 0x3b,
+		OPCODE_RLA_INDIRECT_X = 0x23,
+		OPCODE_RLA_INDIRECT_Y = 0x33,
+		OPCODE_RLA_ZERO_PAGE = 0x27,
+		OPCODE_RLA_ZERO_PAGE_X = 0x37,
+
+		OPCODE_RRA_ABSOLUTE = 0x6f,
+		OPCODE_RRA_ABSOLUTE_X = 0x7f,
+		OPCODE_RRA_ABSOLUTE_Y = 0x7b,
+		OPCODE_RRA_INDIRECT_X = 0x63,
+		OPCODE_RRA_INDIRECT_Y = 0x73,
+		OPCODE_RRA_ZERO_PAGE = 0x67,
+		OPCODE_RRA_ZERO_PAGE_X = 0x77,
+
+		OPCODE_SAX_ABSOLUTE = 0x8f,
+		OPCODE_SAX_INDIRECT_X = 0x83,
+		OPCODE_SAX_ZERO_PAGE = 0x87,
+		OPCODE_SAX_ZERO_PAGE_Y = 0x97,
+
+		OPCODE_SBC_IMMEDIATE_EB = 0xeb,
+
+		OPCODE_SBX_IMMEDIATE = 0xcb,
+
+		OPCODE_SHA_ABSOLUTE_Y = 0x9f,
+		OPCODE_SHA_INDIRECT_Y = 0x93,
+
+		OPCODE_SHX_ABSOLUTE_Y = 0x9e,
+
+		OPCODE_SHY_ABSOLUTE_X = 0x9c,
+
+		OPCODE_SLO_ABSOLUTE = 0xf,
+		OPCODE_SLO_ABSOLUTE_X = 0x1f,
+		OPCODE_SLO_ABSOLUTE_Y = 0x1b,
+		OPCODE_SLO_INDIRECT_X = 0x3,
+		OPCODE_SLO_INDIRECT_Y = 0x13,
+		OPCODE_SLO_ZERO_PAGE = 0x7,
+		OPCODE_SLO_ZERO_PAGE_X = 0x17,
+
+		OPCODE_SRE_ABSOLUTE = 0x4f,
+		OPCODE_SRE_ABSOLUTE_X = 0x5f,
+		OPCODE_SRE_ABSOLUTE_Y = 0x5b,
+		OPCODE_SRE_INDIRECT_X = 0x43,
+		OPCODE_SRE_INDIRECT_Y = 0x53,
+		OPCODE_SRE_ZERO_PAGE = 0x47,
+		OPCODE_SRE_ZERO_PAGE_X = 0x57,
+
+		OPCODE_TAS_ABSOLUTE_Y = 0x9b,
 	};
 
 	static const std::string ADDRESS_STR[] = {
@@ -238,27 +446,365 @@ namespace mirra {
 		((_TYPE_) > ADDRESS_MAX ? STRING_UNKNOWN : \
 		STRING_CHECK(ADDRESS_STR[_TYPE_]))
 
+	static const std::string CPU_PARAMETER_STR[] = {
+		"ENGINE",
+		};
+
+	#define CPU_PARAMETER_STRING(_TYPE_) \
+		((_TYPE_) > CPU_PARAMETER_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(CPU_PARAMETER_STR[_TYPE_]))
+
+	static const std::string ENGINE_STR[] = {
+		"TABLE", "THREADED", "DECODE", "DYNAREC",
+		};
+
+	#define ENGINE_STRING(_TYPE_) \
+		((_TYPE_) > ENGINE_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(ENGINE_STR[_TYPE_]))
+
+	static const std::string CPU_EVENT_STR[] = {
+		"NONE", "BREAKPOINT", "FRAME", "HALT", "INTERRUPT",
+		};
+
+	#define CPU_EVENT_STRING(_TYPE_) \
+		((_TYPE_) > CPU_EVENT_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(CPU_EVENT_STR[_TYPE_]))
+
 	#define FLAG_UNDEFINED "*"
 
 	static const std::string FLAG_STR[] = {
-		"C", "Z", "I", FLAG_UNDEFINED, "B", FLAG_UNDEFINED, "V", "S",
+		"C", "Z", "I", "D", "B", FLAG_UNDEFINED, "V", "S",
 		};
 
 	#define FLAG_STRING(_TYPE_) \
 		((_TYPE_) > FLAG_MAX ? STRING_UNKNOWN : \
 		STRING_CHECK(FLAG_STR[_TYPE_]))
 
+	static constexpr uint8_t ADDRESS_LEN[] = {
+		2, 2, 2, 0, 1, 0, 2, 1, 1, 1, 1, 1, 1,
+		};
+
+	#define ADDRESS_LENGTH(_TYPE_) ADDRESS_LEN[_TYPE_]
+
+	#define INSTRUCTION(_HANDLER_, _MODE_, _CYCLES_, _BOUNDARY_) \
+		{ INSTRUCTION_HANDLER(_HANDLER_, _MODE_), ADDRESS_ ## _MODE_, ADDRESS_LENGTH(ADDRESS_ ## _MODE_), \
+			_CYCLES_, _BOUNDARY_, #_HANDLER_ }
+	#define INSTRUCTION_HANDLER(_HANDLER_, _MODE_) \
+		(&mirra::cpu::execute_ ## _HANDLER_<ADDRESS_ ## _MODE_>)
+	#define INSTRUCTION_JAM INSTRUCTION(jam, IMPLIED, 0, 0)
+
+	#define INSTRUCTION_ROW(_MACRO_, _HIGH_) \
+		_MACRO_(_HIGH_ ## 0) _MACRO_(_HIGH_ ## 1) _MACRO_(_HIGH_ ## 2) _MACRO_(_HIGH_ ## 3) \
+		_MACRO_(_HIGH_ ## 4) _MACRO_(_HIGH_ ## 5) _MACRO_(_HIGH_ ## 6) _MACRO_(_HIGH_ ## 7) \
+		_MACRO_(_HIGH_ ## 8) _MACRO_(_HIGH_ ## 9) _MACRO_(_HIGH_ ## a) _MACRO_(_HIGH_ ## b) \
+		_MACRO_(_HIGH_ ## c) _MACRO_(_HIGH_ ## d) _MACRO_(_HIGH_ ## e) _MACRO_(_HIGH_ ## f)
+	#define INSTRUCTION_EACH(_MACRO_) \
+		INSTRUCTION_ROW(_MACRO_, 0x0) INSTRUCTION_ROW(_MACRO_, 0x1) INSTRUCTION_ROW(_MACRO_, 0x2) \
+		INSTRUCTION_ROW(_MACRO_, 0x3) INSTRUCTION_ROW(_MACRO_, 0x4) INSTRUCTION_ROW(_MACRO_, 0x5) \
+		INSTRUCTION_ROW(_MACRO_, 0x6) INSTRUCTION_ROW(_MACRO_, 0x7) INSTRUCTION_ROW(_MACRO_, 0x8) \
+		INSTRUCTION_ROW(_MACRO_, 0x9) INSTRUCTION_ROW(_MACRO_, 0xa) INSTRUCTION_ROW(_MACRO_, 0xb) \
+		INSTRUCTION_ROW(_MACRO_, 0xc) INSTRUCTION_ROW(_MACRO_, 0xd) INSTRUCTION_ROW(_MACRO_, 0xe) \
+		INSTRUCTION_ROW(_MACRO_, 0xf)
+
+	#define INSTRUCTION_LABEL(_CODE_) &&instruction_ ## _CODE_,
+	#define INSTRUCTION_THREAD(_CODE_) \
+		instruction_ ## _CODE_: \
+			step(INSTRUCTION_TABLE[_CODE_]); \
+			if(m_cycles >= m_cycles_limit) { \
+				return; \
+			} \
+			goto *label[read(m_program_counter++)];
+
+	const mirra::instruction_t cpu::INSTRUCTION_TABLE[INSTRUCTION_MAX + 1] = {
+		INSTRUCTION(brk, IMPLIED, 7, 0), // 0x00
+		INSTRUCTION(ora, INDIRECT_X, 6, 0), // 0x01
+		INSTRUCTION_JAM, // 0x02
+		INSTRUCTION(slo, INDIRECT_X, 8, 0), // 0x03
+		INSTRUCTION(nop, ZERO_PAGE, 3, 0), // 0x04
+		INSTRUCTION(ora, ZERO_PAGE, 3, 0), // 0x05
+		INSTRUCTION(asl, ZERO_PAGE, 5, 0), // 0x06
+		INSTRUCTION(slo, ZERO_PAGE, 5, 0), // 0x07
+		INSTRUCTION(php, IMPLIED, 3, 0), // 0x08
+		INSTRUCTION(ora, IMMEDIATE, 2, 0), // 0x09
+		INSTRUCTION(asl, ACCUMULATOR, 2, 0), // 0x0a
+		INSTRUCTION(anc, IMMEDIATE, 2, 0), // 0x0b
+		INSTRUCTION(nop, ABSOLUTE, 4, 0), // 0x0c
+		INSTRUCTION(ora, ABSOLUTE, 4, 0), // 0x0d
+		INSTRUCTION(asl, ABSOLUTE, 6, 0), // 0x0e
+		INSTRUCTION(slo, ABSOLUTE, 6, 0), // 0x0f
+		INSTRUCTION(bpl, RELATIVE, 2, 0), // 0x10
+		INSTRUCTION(ora, INDIRECT_Y, 5, 1), // 0x11
+		INSTRUCTION_JAM, // 0x12
+		INSTRUCTION(slo, INDIRECT_Y, 8, 0), // 0x13
+		INSTRUCTION(nop, ZERO_PAGE_X, 4, 0), // 0x14
+		INSTRUCTION(ora, ZERO_PAGE_X, 4, 0), // 0x15
+		INSTRUCTION(asl, ZERO_PAGE_X, 6, 0), // 0x16
+		INSTRUCTION(slo, ZERO_PAGE_X, 6, 0), // 0x17
+		INSTRUCTION(clc, IMPLIED, 2, 0), // 0x18
+		INSTRUCTION(ora, ABSOLUTE_Y, 4, 1), // 0x19
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0x1a
+		INSTRUCTION(slo, ABSOLUTE_Y, 7, 0), // 0x1b
+		INSTRUCTION(nop, ABSOLUTE_X, 4, 1), // 0x1c
+		INSTRUCTION(ora, ABSOLUTE_X, 4, 1), // 0x1d
+		INSTRUCTION(asl, ABSOLUTE_X, 7, 0), // 0x1e
+		INSTRUCTION(slo, ABSOLUTE_X, 7, 0), // 0x1f
+		INSTRUCTION(jsr, ABSOLUTE, 6, 0), // 0x20
+		INSTRUCTION(and, INDIRECT_X, 6, 0), // 0x21
+		INSTRUCTION_JAM, // 0x22
+		INSTRUCTION(rla, INDIRECT_X, 8, 0), // 0x23
+		INSTRUCTION(bit, ZERO_PAGE, 3, 0), // 0x24
+		INSTRUCTION(and, ZERO_PAGE, 3, 0), // 0x25
+		INSTRUCTION(rol, ZERO_PAGE, 5, 0), // 0x26
+		INSTRUCTION(rla, ZERO_PAGE, 5, 0), // 0x27
+		INSTRUCTION(plp, IMPLIED, 4, 0), // 0x28
+		INSTRUCTION(and, IMMEDIATE, 2, 0), // 0x29
+		INSTRUCTION(rol, ACCUMULATOR, 2, 0), // 0x2a
+		INSTRUCTION(anc, IMMEDIATE, 2, 0), // 0x2b
+		INSTRUCTION(bit, ABSOLUTE, 4, 0), // 0x2c
+		INSTRUCTION(and, ABSOLUTE, 4, 0), // 0x2d
+		INSTRUCTION(rol, ABSOLUTE, 6, 0), // 0x2e
+		INSTRUCTION(rla, ABSOLUTE, 6, 0), // 0x2f
+		INSTRUCTION(bmi, RELATIVE, 2, 0), // 0x30
+		INSTRUCTION(and, INDIRECT_Y, 5, 1), // 0x31
+		INSTRUCTION_JAM, // 0x32
+		INSTRUCTION(rla, INDIRECT_Y, 8, 0), // 0x33
+		INSTRUCTION(nop, ZERO_PAGE_X, 4, 0), // 0x34
+		INSTRUCTION(and, ZERO_PAGE_X, 4, 0), // 0x35
+		INSTRUCTION(rol, ZERO_PAGE_X, 6, 0), // 0x36
+		INSTRUCTION(rla, ZERO_PAGE_X, 6, 0), // 0x37
+		INSTRUCTION(sec, IMPLIED, 2, 0), // 0x38
+		INSTRUCTION(and, ABSOLUTE_Y, 4, 1), // 0x39
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0x3a
+		INSTRUCTION(rla, ABSOLUTE_Y, 7, 0), // 0x3b
+		INSTRUCTION(nop, ABSOLUTE_X, 4, 1), // 0x3c
+		INSTRUCTION(and, ABSOLUTE_X, 4, 1), // 0x3d
+		INSTRUCTION(rol, ABSOLUTE_X, 7, 0), // 0x3e
+		INSTRUCTION(rla, ABSOLUTE_X, 7, 0), // 0x3f
+		INSTRUCTION(rti, IMPLIED, 6, 0), // 0x40
+		INSTRUCTION(eor, INDIRECT_X, 6, 0), // 0x41
+		INSTRUCTION_JAM, // 0x42
+		INSTRUCTION(sre, INDIRECT_X, 8, 0), // 0x43
+		INSTRUCTION(nop, ZERO_PAGE, 3, 0), // 0x44
+		INSTRUCTION(eor, ZERO_PAGE, 3, 0), // 0x45
+		INSTRUCTION(lsr, ZERO_PAGE, 5, 0), // 0x46
+		INSTRUCTION(sre, ZERO_PAGE, 5, 0), // 0x47
+		INSTRUCTION(pha, IMPLIED, 3, 0), // 0x48
+		INSTRUCTION(eor, IMMEDIATE, 2, 0), // 0x49
+		INSTRUCTION(lsr, ACCUMULATOR, 2, 0), // 0x4a
+		INSTRUCTION(alr, IMMEDIATE, 2, 0), // 0x4b
+		INSTRUCTION(jmp, ABSOLUTE, 3, 0), // 0x4c
+		INSTRUCTION(eor, ABSOLUTE, 4, 0), // 0x4d
+		INSTRUCTION(lsr, ABSOLUTE, 6, 0), // 0x4e
+		INSTRUCTION(sre, ABSOLUTE, 6, 0), // 0x4f
+		INSTRUCTION(bvc, RELATIVE, 2, 0), // 0x50
+		INSTRUCTION(eor, INDIRECT_Y, 5, 1), // 0x51
+		INSTRUCTION_JAM, // 0x52
+		INSTRUCTION(sre, INDIRECT_Y, 8, 0), // 0x53
+		INSTRUCTION(nop, ZERO_PAGE_X, 4, 0), // 0x54
+		INSTRUCTION(eor, ZERO_PAGE_X, 4, 0), // 0x55
+		INSTRUCTION(lsr, ZERO_PAGE_X, 6, 0), // 0x56
+		INSTRUCTION(sre, ZERO_PAGE_X, 6, 0), // 0x57
+		INSTRUCTION(cli, IMPLIED, 2, 0), // 0x58
+		INSTRUCTION(eor, ABSOLUTE_Y, 4, 1), // 0x59
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0x5a
+		INSTRUCTION(sre, ABSOLUTE_Y, 7, 0), // 0x5b
+		INSTRUCTION(nop, ABSOLUTE_X, 4, 1), // 0x5c
+		INSTRUCTION(eor, ABSOLUTE_X, 4, 1), // 0x5d
+		INSTRUCTION(lsr, ABSOLUTE_X, 7, 0), // 0x5e
+		INSTRUCTION(sre, ABSOLUTE_X, 7, 0), // 0x5f
+		INSTRUCTION(rts, IMPLIED, 6, 0), // 0x60
+		INSTRUCTION(adc, INDIRECT_X, 6, 0), // 0x61
+		INSTRUCTION_JAM, // 0x62
+		INSTRUCTION(rra, INDIRECT_X, 8, 0), // 0x63
+		INSTRUCTION(nop, ZERO_PAGE, 3, 0), // 0x64
+		INSTRUCTION(adc, ZERO_PAGE, 3, 0), // 0x65
+		INSTRUCTION(ror, ZERO_PAGE, 5, 0), // 0x66
+		INSTRUCTION(rra, ZERO_PAGE, 5, 0), // 0x67
+		INSTRUCTION(pla, IMPLIED, 4, 0), // 0x68
+		INSTRUCTION(adc, IMMEDIATE, 2, 0), // 0x69
+		INSTRUCTION(ror, ACCUMULATOR, 2, 0), // 0x6a
+		INSTRUCTION(arr, IMMEDIATE, 2, 0), // 0x6b
+		INSTRUCTION(jmp, INDIRECT, 5, 0), // 0x6c
+		INSTRUCTION(adc, ABSOLUTE, 4, 0), // 0x6d
+		INSTRUCTION(ror, ABSOLUTE, 6, 0), // 0x6e
+		INSTRUCTION(rra, ABSOLUTE, 6, 0), // 0x6f
+		INSTRUCTION(bvs, RELATIVE, 2, 0), // 0x70
+		INSTRUCTION(adc, INDIRECT_Y, 5, 1), // 0x71
+		INSTRUCTION_JAM, // 0x72
+		INSTRUCTION(rra, INDIRECT_Y, 8, 0), // 0x73
+		INSTRUCTION(nop, ZERO_PAGE_X, 4, 0), // 0x74
+		INSTRUCTION(adc, ZERO_PAGE_X, 4, 0), // 0x75
+		INSTRUCTION(ror, ZERO_PAGE_X, 6, 0), // 0x76
+		INSTRUCTION(rra, ZERO_PAGE_X, 6, 0), // 0x77
+		INSTRUCTION(sei, IMPLIED, 2, 0), // 0x78
+		INSTRUCTION(adc, ABSOLUTE_Y, 4, 1), // 0x79
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0x7a
+		INSTRUCTION(rra, ABSOLUTE_Y, 7, 0), // 0x7b
+		INSTRUCTION(nop, ABSOLUTE_X, 4, 1), // 0x7c
+		INSTRUCTION(adc, ABSOLUTE_X, 4, 1), // 0x7d
+		INSTRUCTION(ror, ABSOLUTE_X, 7, 0), // 0x7e
+		INSTRUCTION(rra, ABSOLUTE_X, 7, 0), // 0x7f
+		INSTRUCTION(nop, IMMEDIATE, 2, 0), // 0x80
+		INSTRUCTION(sta, INDIRECT_X, 6, 0), // 0x81
+		INSTRUCTION(nop, IMMEDIATE, 2, 0), // 0x82
+		INSTRUCTION(sax, INDIRECT_X, 6, 0), // 0x83
+		INSTRUCTION(sty, ZERO_PAGE, 3, 0), // 0x84
+		INSTRUCTION(sta, ZERO_PAGE, 3, 0), // 0x85
+		INSTRUCTION(stx, ZERO_PAGE, 3, 0), // 0x86
+		INSTRUCTION(sax, ZERO_PAGE, 3, 0), // 0x87
+		INSTRUCTION(dey, IMPLIED, 2, 0), // 0x88
+		INSTRUCTION(nop, IMMEDIATE, 2, 0), // 0x89
+		INSTRUCTION(txa, IMPLIED, 2, 0), // 0x8a
+		INSTRUCTION(ane, IMMEDIATE, 2, 0), // 0x8b
+		INSTRUCTION(sty, ABSOLUTE, 4, 0), // 0x8c
+		INSTRUCTION(sta, ABSOLUTE, 4, 0), // 0x8d
+		INSTRUCTION(stx, ABSOLUTE, 4, 0), // 0x8e
+		INSTRUCTION(sax, ABSOLUTE, 4, 0), // 0x8f
+		INSTRUCTION(bcc, RELATIVE, 2, 0), // 0x90
+		INSTRUCTION(sta, INDIRECT_Y, 6, 0), // 0x91
+		INSTRUCTION_JAM, // 0x92
+		INSTRUCTION(sha, INDIRECT_Y, 6, 0), // 0x93
+		INSTRUCTION(sty, ZERO_PAGE_X, 4, 0), // 0x94
+		INSTRUCTION(sta, ZERO_PAGE_X, 4, 0), // 0x95
+		INSTRUCTION(stx, ZERO_PAGE_Y, 4, 0), // 0x96
+		INSTRUCTION(sax, ZERO_PAGE_Y, 4, 0), // 0x97
+		INSTRUCTION(tya, IMPLIED, 2, 0), // 0x98
+		INSTRUCTION(sta, ABSOLUTE_Y, 5, 0), // 0x99
+		INSTRUCTION(txs, IMPLIED, 2, 0), // 0x9a
+		INSTRUCTION(tas, ABSOLUTE_Y, 5, 0), // 0x9b
+		INSTRUCTION(shy, ABSOLUTE_X, 5, 0), // 0x9c
+		INSTRUCTION(sta, ABSOLUTE_X, 5, 0), // 0x9d
+		INSTRUCTION(shx, ABSOLUTE_Y, 5, 0), // 0x9e
+		INSTRUCTION(sha, ABSOLUTE_Y, 5, 0), // 0x9f
+		INSTRUCTION(ldy, IMMEDIATE, 2, 0), // 0xa0
+		INSTRUCTION(lda, INDIRECT_X, 6, 0), // 0xa1
+		INSTRUCTION(ldx, IMMEDIATE, 2, 0), // 0xa2
+		INSTRUCTION(lax, INDIRECT_X, 6, 0), // 0xa3
+		INSTRUCTION(ldy, ZERO_PAGE, 3, 0), // 0xa4
+		INSTRUCTION(lda, ZERO_PAGE, 3, 0), // 0xa5
+		INSTRUCTION(ldx, ZERO_PAGE, 3, 0), // 0xa6
+		INSTRUCTION(lax, ZERO_PAGE, 3, 0), // 0xa7
+		INSTRUCTION(tay, IMPLIED, 2, 0), // 0xa8
+		INSTRUCTION(lda, IMMEDIATE, 2, 0), // 0xa9
+		INSTRUCTION(tax, IMPLIED, 2, 0), // 0xaa
+		INSTRUCTION(lxa, IMMEDIATE, 2, 0), // 0xab
+		INSTRUCTION(ldy, ABSOLUTE, 4, 0), // 0xac
+		INSTRUCTION(lda, ABSOLUTE, 4, 0), // 0xad
+		INSTRUCTION(ldx, ABSOLUTE, 4, 0), // 0xae
+		INSTRUCTION(lax, ABSOLUTE, 4, 0), // 0xaf
+		INSTRUCTION(bcs, RELATIVE, 2, 0), // 0xb0
+		INSTRUCTION(lda, INDIRECT_Y, 5, 1), // 0xb1
+		INSTRUCTION_JAM, // 0xb2
+		INSTRUCTION(lax, INDIRECT_Y, 5, 1), // 0xb3
+		INSTRUCTION(ldy, ZERO_PAGE_X, 4, 0), // 0xb4
+		INSTRUCTION(lda, ZERO_PAGE_X, 4, 0), // 0xb5
+		INSTRUCTION(ldx, ZERO_PAGE_Y, 4, 0), // 0xb6
+		INSTRUCTION(lax, ZERO_PAGE_Y, 4, 0), // 0xb7
+		INSTRUCTION(clv, IMPLIED, 2, 0), // 0xb8
+		INSTRUCTION(lda, ABSOLUTE_Y, 4, 1), // 0xb9
+		INSTRUCTION(tsx, IMPLIED, 2, 0), // 0xba
+		INSTRUCTION(las, ABSOLUTE_Y, 4, 1), // 0xbb
+		INSTRUCTION(ldy, ABSOLUTE_X, 4, 1), // 0xbc
+		INSTRUCTION(lda, ABSOLUTE_X, 4, 1), // 0xbd
+		INSTRUCTION(ldx, ABSOLUTE_Y, 4, 1), // 0xbe
+		INSTRUCTION(lax, ABSOLUTE_Y, 4, 1), // 0xbf
+		INSTRUCTION(cpy, IMMEDIATE, 2, 0), // 0xc0
+		INSTRUCTION(cmp, INDIRECT_X, 6, 0), // 0xc1
+		INSTRUCTION(nop, IMMEDIATE, 2, 0), // 0xc2
+		INSTRUCTION(dcp, INDIRECT_X, 8, 0), // 0xc3
+		INSTRUCTION(cpy, ZERO_PAGE, 3, 0), // 0xc4
+		INSTRUCTION(cmp, ZERO_PAGE, 3, 0), // 0xc5
+		INSTRUCTION(dec, ZERO_PAGE, 5, 0), // 0xc6
+		INSTRUCTION(dcp, ZERO_PAGE, 5, 0), // 0xc7
+		INSTRUCTION(iny, IMPLIED, 2, 0), // 0xc8
+		INSTRUCTION(cmp, IMMEDIATE, 2, 0), // 0xc9
+		INSTRUCTION(dex, IMPLIED, 2, 0), // 0xca
+		INSTRUCTION(sbx, IMMEDIATE, 2, 0), // 0xcb
+		INSTRUCTION(cpy, ABSOLUTE, 4, 0), // 0xcc
+		INSTRUCTION(cmp, ABSOLUTE, 4, 0), // 0xcd
+		INSTRUCTION(dec, ABSOLUTE, 6, 0), // 0xce
+		INSTRUCTION(dcp, ABSOLUTE, 6, 0), // 0xcf
+		INSTRUCTION(bne, RELATIVE, 2, 0), // 0xd0
+		INSTRUCTION(cmp, INDIRECT_Y, 5, 1), // 0xd1
+		INSTRUCTION_JAM, // 0xd2
+		INSTRUCTION(dcp, INDIRECT_Y, 8, 0), // 0xd3
+		INSTRUCTION(nop, ZERO_PAGE_X, 4, 0), // 0xd4
+		INSTRUCTION(cmp, ZERO_PAGE_X, 4, 0), // 0xd5
+		INSTRUCTION(dec, ZERO_PAGE_X, 6, 0), // 0xd6
+		INSTRUCTION(dcp, ZERO_PAGE_X, 6, 0), // 0xd7
+		INSTRUCTION(cld, IMPLIED, 2, 0), // 0xd8
+		INSTRUCTION(cmp, ABSOLUTE_Y, 4, 1), // 0xd9
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0xda
+		INSTRUCTION(dcp, ABSOLUTE_Y, 7, 0), // 0xdb
+		INSTRUCTION(nop, ABSOLUTE_X, 4, 1), // 0xdc
+		INSTRUCTION(cmp, ABSOLUTE_X, 4, 1), // 0xdd
+		INSTRUCTION(dec, ABSOLUTE_X, 7, 0), // 0xde
+		INSTRUCTION(dcp, ABSOLUTE_X, 7, 0), // 0xdf
+		INSTRUCTION(cpx, IMMEDIATE, 2, 0), // 0xe0
+		INSTRUCTION(sbc, INDIRECT_X, 6, 0), // 0xe1
+		INSTRUCTION(nop, IMMEDIATE, 2, 0), // 0xe2
+		INSTRUCTION(isc, INDIRECT_X, 8, 0), // 0xe3
+		INSTRUCTION(cpx, ZERO_PAGE, 3, 0), // 0xe4
+		INSTRUCTION(sbc, ZERO_PAGE, 3, 0), // 0xe5
+		INSTRUCTION(inc, ZERO_PAGE, 5, 0), // 0xe6
+		INSTRUCTION(isc, ZERO_PAGE, 5, 0), // 0xe7
+		INSTRUCTION(inx, IMPLIED, 2, 0), // 0xe8
+		INSTRUCTION(sbc, IMMEDIATE, 2, 0), // 0xe9
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0xea
+		INSTRUCTION(sbc, IMMEDIATE, 2, 0), // 0xeb
+		INSTRUCTION(cpx, ABSOLUTE, 4, 0), // 0xec
+		INSTRUCTION(sbc, ABSOLUTE, 4, 0), // 0xed
+		INSTRUCTION(inc, ABSOLUTE, 6, 0), // 0xee
+		INSTRUCTION(isc, ABSOLUTE, 6, 0), // 0xef
+		INSTRUCTION(beq, RELATIVE, 2, 0), // 0xf0
+		INSTRUCTION(sbc, INDIRECT_Y, 5, 1), // 0xf1
+		INSTRUCTION_JAM, // 0xf2
+		INSTRUCTION(isc, INDIRECT_Y, 8, 0), // 0xf3
+		INSTRUCTION(nop, ZERO_PAGE_X, 4, 0), // 0xf4
+		INSTRUCTION(sbc, ZERO_PAGE_X, 4, 0), // 0xf5
+		INSTRUCTION(inc, ZERO_PAGE_X, 6, 0), // 0xf6
+		INSTRUCTION(isc, ZERO_PAGE_X, 6, 0), // 0xf7
+		INSTRUCTION(sed, IMPLIED, 2, 0), // 0xf8
+		INSTRUCTION(sbc, ABSOLUTE_Y, 4, 1), // 0xf9
+		INSTRUCTION(nop, IMPLIED, 2, 0), // 0xfa
+		INSTRUCTION(isc, ABSOLUTE_Y, 7, 0), // 0xfb
+		INSTRUCTION(nop, ABSOLUTE_X, 4, 1), // 0xfc
+		INSTRUCTION(sbc, ABSOLUTE_X, 4, 1), // 0xfd
+		INSTRUCTION(inc, ABSOLUTE_X, 7, 0), // 0xfe
+		INSTRUCTION(isc, ABSOLUTE_X, 7, 0), // 0xff
+		};
+
 	cpu::cpu(void) :
 		mirra::singleton<mirra::cpu>(OBJECT_CPU),
 		m_accumulator(REGISTER_ACCUMULATOR_DEFAULT),
+		m_boundary(false),
+		m_carry(REGISTER_CARRY_DEFAULT),
 		m_cycles(0),
+		m_cycles_limit(0),
+		m_cycles_target(0),
+		m_dynarec(nullptr),
+		m_dynarec_offset(0),
+		m_engine(ENGINE_TABLE),
+		m_event(CPU_EVENT_NONE),
 		m_flag(REGISTER_FLAG_DEFAULT),
+		m_halted(false),
 		m_index_x(REGISTER_INDEX_X_DEFAULT),
 		m_index_y(REGISTER_INDEX_Y_DEFAULT),
 		m_initialized(false),
+		m_interrupt(0),
+		m_interrupt_delay(false),
+		m_interrupt_line(0),
+		m_mmu(mirra::mmu::acquire()),
+		m_overflow(REGISTER_OVERFLOW_DEFAULT),
 		m_program_counter(REGISTER_PROGRAM_COUNTER_DEFAULT),
+		m_ram(nullptr),
+		m_sign(REGISTER_SIGN_DEFAULT),
 		m_stack_pointer(REGISTER_STACK_POINTER_DEFAULT),
-		m_started(false)
+		m_started(false),
+#if TRACE >= TRACE_INSTRUCTION
+		m_trace(mirra::trace::acquire()),
+#endif // TRACE >= TRACE_INSTRUCTION
+		m_zero(REGISTER_ZERO_DEFAULT)
 	{
 		return;
 	}
@@ -268,295 +814,2406 @@ namespace mirra {
 		return;
 	}
 
-	void 
-	cpu::clear(void)
+	inline void 
+	cpu::add(
+		__in uint8_t value
+		)
 	{
-		m_accumulator = REGISTER_ACCUMULATOR_DEFAULT;
-		m_cycles = 0;
-		m_flag = REGISTER_FLAG_DEFAULT;
-		m_index_x = REGISTER_INDEX_X_DEFAULT;
-		m_index_y = REGISTER_INDEX_Y_DEFAULT;
-		m_program_counter = REGISTER_PROGRAM_COUNTER_DEFAULT;
-		m_stack_pointer = REGISTER_STACK_POINTER_DEFAULT;
+		uint16_t result;
+
+		result = (m_accumulator + value + m_carry);
+		m_carry = (result > UINT8_MAX);
+		m_overflow = (~(m_accumulator ^ value) & (m_accumulator ^ result));
+		m_accumulator = WORD_LOW(result);
+		set_sign_zero(m_accumulator);
 	}
 
-	uint16_t 
-	cpu::indirect_address(
-		__in mirra::address_t mode,
-		__in uint16_t address,
-		__out bool &boundary
+	void 
+	cpu::branch(
+		__in bool condition,
+		__in uint16_t operand
 		)
 	{
-		uint16_t result = 0;
+		uint16_t address;
+
+		if(condition) {
+			address = (m_program_counter + (int8_t) operand);
+			m_cycles += ((WORD_HIGH(address) != WORD_HIGH(m_program_counter)) ? 2 : 1);
+
+			if(((uint16_t) (m_program_counter - address) > ADDRESS_LENGTH(ADDRESS_RELATIVE))
+					&& ((uint16_t) (m_program_counter - address) <= IDLE_LENGTH_MAX)
+					&& m_breakpoint.empty()
+#if TRACE >= TRACE_INSTRUCTION
+					&& !m_trace.is_started()
+#endif // TRACE >= TRACE_INSTRUCTION
+					) {
+				idle(address, m_program_counter - (ADDRESS_LENGTH(ADDRESS_RELATIVE) + 1));
+			} else {
+				m_idle.valid = false;
+			}
 
-		switch(mode) {
-			case ADDRESS_ABSOLUTE_X:
-				result = (address + m_index_x);
-				boundary = (((address & UINT8_MAX) + m_index_x) > UINT8_MAX);
-				break;
-			case ADDRESS_ABSOLUTE_Y:
-				result = (address + m_index_y);
-				boundary = (((address & UINT8_MAX) + m_index_y) > UINT8_MAX);
-				break;
-			case ADDRESS_INDIRECT:
-				result = read_word(address);
-				boundary = false;
-				break;
-			case ADDRESS_INDIRECT_X:
-				result = read_word(address + m_index_x);
-				boundary = false;
-				break;
-			case ADDRESS_INDIRECT_Y:
-				result = read_word(address);
-				boundary = (((result & UINT8_MAX) + m_index_y) > UINT8_MAX);
-				result += m_index_y;
-				break;
-			case ADDRESS_ZERO_PAGE_X:
-				result = ((address + m_index_x) % UINT8_MAX);
-				boundary = false;
-				break;
-			case ADDRESS_ZERO_PAGE_Y:
-				result = ((address + m_index_y) % UINT8_MAX);
-				boundary = false;
-				break;
-			default:
-				THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_INVALID_INDIRECT,
-					"%s (%x)", ADDRESS_STRING(mode), mode);
+			m_program_counter = address;
+		} else if(m_idle.branch == (uint16_t) (m_program_counter - (ADDRESS_LENGTH(ADDRESS_RELATIVE) + 1))) {
+			m_idle.valid = false;
 		}
-
-		return result;
 	}
 
 	void 
-	cpu::initialize(
-		__in_opt const mirra::parameter_t &parameter
+	cpu::breakpoint_add(
+		__in uint16_t address
 		)
 	{
 
-		if(m_initialized) {
-			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_INITIALIZED);
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
 		}
 
-		m_initialized = true;
+		m_breakpoint.insert(address);
 	}
 
 	void 
-	cpu::irq(void)
+	cpu::breakpoint_clear(void)
 	{
-		push_word(m_program_counter);
-		push(*(uint8_t *) &m_flag);
-		m_flag.interrupt_disable = true;
-		m_program_counter = read_word(INTERRUPT_IRQ);
-	}
 
-	bool 
-	cpu::is_initialized(void)
-	{
-		return m_initialized;
-	}
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
 
-	bool 
-	cpu::is_started(void)
-	{
-		return m_started;
+		m_breakpoint.clear();
 	}
 
 	void 
-	cpu::nmi(void)
+	cpu::breakpoint_remove(
+		__in uint16_t address
+		)
 	{
-		push_word(m_program_counter);
-		push(*(uint8_t *) &m_flag);
-		m_flag.interrupt_disable = true;
-		m_program_counter = read_word(INTERRUPT_NMI);
-	}
+		std::set<uint16_t>::iterator iter;
 
-	uint8_t 
-	cpu::pop(void)
-	{
-		return read(++m_stack_pointer + STACK_BASE);
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		iter = m_breakpoint.find(address);
+		if(iter == m_breakpoint.end()) {
+			THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_BREAKPOINT_NOT_FOUND,
+				"%04x", address);
+		}
+
+		m_breakpoint.erase(iter);
 	}
 
-	uint16_t 
-	cpu::pop_word(void)
+	void 
+	cpu::clear(void)
 	{
-		return WORD(pop(), pop());
+		std::vector<mirra::decode_block_t>::iterator iter;
+
+		for(iter = m_decode.begin(); iter != m_decode.end(); ++iter) {
+			iter->source = nullptr;
+			iter->count = 0;
+			iter->hits = 0;
+			iter->native = nullptr;
+		}
+
+		if(m_dynarec) {
+			dynarec_flush();
+		}
+
+		m_accumulator = REGISTER_ACCUMULATOR_DEFAULT;
+		m_boundary = false;
+		m_carry = REGISTER_CARRY_DEFAULT;
+		m_cycles = 0;
+		m_cycles_limit = 0;
+		m_cycles_target = 0;
+		m_event = CPU_EVENT_NONE;
+		m_flag = REGISTER_FLAG_DEFAULT;
+		m_halted = false;
+		m_idle.address = 0;
+		m_idle.branch = 0;
+		m_idle.generation = 0;
+		m_idle.pure = false;
+		m_idle.valid = false;
+		m_index_x = REGISTER_INDEX_X_DEFAULT;
+		m_index_y = REGISTER_INDEX_Y_DEFAULT;
+		m_interrupt = 0;
+		m_interrupt_delay = false;
+		m_interrupt_line = 0;
+		m_overflow = REGISTER_OVERFLOW_DEFAULT;
+		m_program_counter = REGISTER_PROGRAM_COUNTER_DEFAULT;
+		m_sign = REGISTER_SIGN_DEFAULT;
+		m_stack_pointer = REGISTER_STACK_POINTER_DEFAULT;
+		m_zero = REGISTER_ZERO_DEFAULT;
 	}
 
 	void 
-	cpu::push(
-		__in uint8_t value
+	cpu::compare(
+		__in uint8_t left,
+		__in uint8_t right
 		)
 	{
-		write(m_stack_pointer-- + STACK_BASE, value);
+		m_carry = (left >= right);
+		set_sign_zero(left - right);
 	}
 
-	void 
-	cpu::push_word(
-		__in uint16_t value
-		)
+	uint64_t 
+	cpu::cycles(void)
 	{
-		push(WORD_HIGH(value));
-		push(WORD_LOW(value));
+		return m_cycles;
 	}
 
-	uint8_t 
-	cpu::read(
-		__in uint16_t address
-		)
+	mirra::cpu_event_t 
+	cpu::event(void)
 	{
+		mirra::cpu_event_t result = m_event;
 
-		// TODO: read byte from MMU
-		return 0;
-		// ---
+		m_event = CPU_EVENT_NONE;
+		return result;
 	}
 
-	uint16_t 
-	cpu::read_word(
+	mirra::decode_block_t &
+	cpu::decode(
 		__in uint16_t address
 		)
 	{
-		return WORD(read(address), read(address + 1));
-	}
+		uint16_t offset;
+		const uint8_t *source = nullptr;
+		const mirra::instruction_t *entry;
+		const mirra::mmu_page_t &page = m_mmu.page(address);
+		mirra::decode_block_t &result = m_decode[address & DECODE_CACHE_MASK];
+
+		if(page.read && (!page.write || ((page.write == page.read)
+				&& (page.read != m_ram) && (page.read != (m_ram + MMU_PAGE_SIZE))))) {
+			source = (page.read + MMU_PAGE_OFFSET(address));
+		}
 
-	template <typename T> std::string 
-	cpu::register_as_string(
-		__in T value,
-		__in_opt bool verbose,
-		__in_opt bool flag
-		)
-	{
-		int iter;
-		std::stringstream result;
+		if((result.source != source) || (result.address != address)) {
+			result.source = source;
+			result.address = address;
+			result.count = 0;
+			result.hits = 0;
+			result.native = nullptr;
 
-		result << SCALAR_AS_HEX(T, value);
+			for(offset = MMU_PAGE_OFFSET(address); source && (offset <= MMU_PAGE_MASK)
+					&& (result.count < DECODE_BLOCK_MAX);) {
+				entry = &INSTRUCTION_TABLE[page.read[offset]];
 
-		if(verbose) {
-			result << " (";
+				if((entry->handler == INSTRUCTION_HANDLER(jam, IMPLIED))
+						|| ((offset + entry->length) > MMU_PAGE_MASK)) {
+					break;
+				}
 
-			for(iter = ((CHAR_BIT * sizeof(T)) - 1); iter >= 0; --iter) {
+				mirra::decode_t &instruction = result.instruction[result.count++];
+				instruction.entry = entry;
+
+				switch(entry->length) {
+					case 1:
+						instruction.operand = page.read[offset + 1];
+						break;
+					case 2:
+						instruction.operand = WORD(page.read[offset + 1], page.read[offset + 2]);
+						break;
+					default:
+						instruction.operand = 0;
+						break;
+				}
 
-				if(flag && (iter <= FLAG_MAX)) {
-					result << (BIT_CHECK(value, iter) ? FLAG_STRING(iter) : FLAG_UNDEFINED);
-				} else {
-					result << (BIT_CHECK(value, iter) ? "1" : "0");
+				offset += (entry->length + 1);
+
+				if(DECODE_TERMINAL(*entry)) {
+					break;
 				}
 			}
 
-			result << ")";
+			if(result.count && page.write) {
+				m_decode_page[MMU_PAGE(address) >> MMU_CODE_WIDTH] |= (1U << (MMU_PAGE(address) & MMU_CODE_MASK));
+				m_mmu.code(address);
+			}
 		}
 
-		return result.str();
+		return result;
 	}
 
 	void 
-	cpu::reset(void)
+	cpu::dynarec_allocate(void)
 	{
-		clear();
-		m_program_counter = read_word(INTERRUPT_RESET);
+#ifdef DYNAREC_SUPPORTED
+		void *result;
+
+		if(!m_dynarec) {
+
+			result = mmap(nullptr, DYNAREC_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if(result == MAP_FAILED) {
+				THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_DYNAREC_ALLOCATION,
+					"%u bytes", DYNAREC_SIZE);
+			}
+
+			m_dynarec = (uint8_t *) result;
+			dynarec_flush();
+		}
+#endif // DYNAREC_SUPPORTED
 	}
 
 	void 
-	cpu::start(
-		__in_opt const mirra::parameter_t &parameter
-		)
+	cpu::dynarec_flush(void)
 	{
+		uint8_t *cursor;
+		std::vector<mirra::decode_block_t>::iterator iter;
 
-		if(!m_initialized) {
-			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
-		}
-
-		if(m_started) {
-			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_STARTED);
+		for(iter = m_decode.begin(); iter != m_decode.end(); ++iter) {
+			iter->hits = 0;
+			iter->native = nullptr;
 		}
 
-		reset();
-		m_started = true;
+		cursor = (m_dynarec + DYNAREC_ENTER);
+		DYNAREC_EMIT_8(cursor, 0x53); // push rbx
+		DYNAREC_EMIT_16(cursor, 0x5441); // push r12
+		DYNAREC_EMIT_32(cursor, 0x08ec8348); // sub rsp, 8
+		DYNAREC_EMIT_8(cursor, 0x48); // mov rbx, rdi
+		DYNAREC_EMIT_16(cursor, 0xfb89);
+		DYNAREC_EMIT_16(cursor, 0xe6ff); // jmp rsi
+
+		cursor = (m_dynarec + DYNAREC_EXIT);
+		DYNAREC_EMIT_32(cursor, 0x08c48348); // add rsp, 8
+		DYNAREC_EMIT_16(cursor, 0x5c41); // pop r12
+		DYNAREC_EMIT_8(cursor, 0x5b); // pop rbx
+		DYNAREC_EMIT_8(cursor, 0xc3); // ret
+
+		m_dynarec_offset = DYNAREC_START;
 	}
 
 	void 
-	cpu::stop(void)
+	cpu::dynarec_free(void)
 	{
+#ifdef DYNAREC_SUPPORTED
 
-		if(!m_initialized) {
-			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
-		}
-
-		if(m_started) {
-			clear();
-			m_started = false;
+		if(m_dynarec) {
+			munmap(m_dynarec, DYNAREC_SIZE);
+			m_dynarec = nullptr;
+			m_dynarec_offset = 0;
 		}
+#endif // DYNAREC_SUPPORTED
 	}
 
-	std::string 
-	cpu::to_string(
-		__in_opt bool verbose
+	bool 
+	cpu::dynarec_translate(
+		__in mirra::decode_block_t &block
 		)
 	{
-		std::stringstream result;
+		bool result = false;
+#ifdef DYNAREC_SUPPORTED
+		uint8_t iter;
+		uintptr_t handler[2];
+		uint16_t address, target[2];
+		uint32_t count = 0, target_count = 0;
+		uint8_t *cursor, *fixup[(DECODE_BLOCK_MAX * 2) + 16], *next;
+
+		result = (m_dynarec && block.count);
+
+		for(iter = 0; result && (iter < block.count); ++iter) {
+			std::memcpy(handler, &block.instruction[iter].entry->handler, sizeof(handler));
+			result = (!BIT_CHECK(handler[0], 0) && !handler[1]);
+		}
 
-		result << mirra::object::as_string(*this, verbose)
-			<< " (" << (m_initialized ? "INIT" : "UNINIT")
-			<< ", " << (m_started ? "START" : "STOP") << ")";
+		if(!result) {
+			block.hits = 0;
+		} else {
 
-		if(m_initialized) {
-			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this);
+			if((m_dynarec_offset + DYNAREC_BLOCK_SIZE) > DYNAREC_SIZE) {
+				dynarec_flush();
+			}
 
-			if(m_started) {
-				result << ", CYCLES=" << m_cycles
-					<< ", A=" << mirra::cpu::register_as_string<uint8_t>(m_accumulator, verbose)
-					<< ", X=" << mirra::cpu::register_as_string<uint8_t>(m_index_x, verbose)
-					<< ", Y=" << mirra::cpu::register_as_string<uint8_t>(m_index_y, verbose)
-					<< ", FLG=" << mirra::cpu::register_as_string<uint8_t>(*(uint8_t *) &m_flag, verbose, true)
-					<< ", PC=" << mirra::cpu::register_as_string<uint16_t>(m_program_counter, verbose)
-					<< ", SP=" << mirra::cpu::register_as_string<uint16_t>(m_stack_pointer + STACK_BASE,
-						verbose);
+			cursor = (m_dynarec + m_dynarec_offset);
+			DYNAREC_EMIT_16(cursor, 0xb848); // mov rax, &generation
+			DYNAREC_EMIT_64(cursor, (uintptr_t) &m_mmu.generation());
+			DYNAREC_EMIT_8(cursor, 0x44); // mov r12d, [rax]
+			DYNAREC_EMIT_16(cursor, 0x208b);
+
+			address = block.address;
+
+			for(iter = 0; iter < block.count; ++iter) {
+				const mirra::instruction_t &entry = *block.instruction[iter].entry;
+
+				std::memcpy(handler, &entry.handler, sizeof(handler));
+				address += (entry.length + 1);
+				DYNAREC_EMIT_32(cursor, 0x00838366); // add word [rbx + pc], length
+				cursor -= sizeof(uint8_t);
+				DYNAREC_EMIT_32(cursor, DYNAREC_OFFSET(m_program_counter));
+				DYNAREC_EMIT_8(cursor, entry.length + 1);
+				DYNAREC_EMIT_8(cursor, 0x48); // mov rdi, rbx
+				DYNAREC_EMIT_16(cursor, 0xdf89);
+				DYNAREC_EMIT_8(cursor, 0xbe); // mov esi, operand
+				DYNAREC_EMIT_32(cursor, block.instruction[iter].operand);
+				DYNAREC_EMIT_16(cursor, 0xb848); // mov rax, handler
+				DYNAREC_EMIT_64(cursor, handler[0]);
+				DYNAREC_EMIT_16(cursor, 0xd0ff); // call rax
+				DYNAREC_EMIT_8(cursor, 0xb8); // mov eax, cycles
+				DYNAREC_EMIT_32(cursor, entry.cycles);
+
+				if(entry.boundary) {
+					DYNAREC_EMIT_16(cursor, 0xb60f); // movzx ecx, byte [rbx + boundary]
+					DYNAREC_EMIT_8(cursor, 0x8b);
+					DYNAREC_EMIT_32(cursor, DYNAREC_OFFSET(m_boundary));
+					DYNAREC_EMIT_16(cursor, 0xd9f7); // neg ecx
+					DYNAREC_EMIT_16(cursor, 0xe181); // and ecx, boundary
+					DYNAREC_EMIT_32(cursor, entry.boundary);
+					DYNAREC_EMIT_16(cursor, 0xc801); // add eax, ecx
+				}
+
+				DYNAREC_EMIT_8(cursor, 0x48); // add [rbx + cycles], rax
+				DYNAREC_EMIT_16(cursor, 0x8301);
+				DYNAREC_EMIT_32(cursor, DYNAREC_OFFSET(m_cycles));
+				DYNAREC_EMIT_8(cursor, 0x48); // mov rax, [rbx + cycles]
+				DYNAREC_EMIT_16(cursor, 0x838b);
+				DYNAREC_EMIT_32(cursor, DYNAREC_OFFSET(m_cycles));
+				DYNAREC_EMIT_8(cursor, 0x48); // cmp rax, [rbx + cycles_limit]
+				DYNAREC_EMIT_16(cursor, 0x833b);
+				DYNAREC_EMIT_32(cursor, DYNAREC_OFFSET(m_cycles_limit));
+				DYNAREC_EMIT_16(cursor, 0x830f); // jae exit
+				fixup[count++] = cursor;
+				DYNAREC_EMIT_32(cursor, 0);
+
+				if(((iter + 1) < block.count) && !DYNAREC_TRANSPARENT_MODE(entry.mode)) {
+					DYNAREC_EMIT_16(cursor, 0xb848); // mov rax, &generation
+					DYNAREC_EMIT_64(cursor, (uintptr_t) &m_mmu.generation());
+					DYNAREC_EMIT_8(cursor, 0x44); // cmp r12d, [rax]
+					DYNAREC_EMIT_16(cursor, 0x203b);
+					DYNAREC_EMIT_16(cursor, 0x850f); // jne exit
+					fixup[count++] = cursor;
+					DYNAREC_EMIT_32(cursor, 0);
+				}
 			}
-		}
 
-		return result.str();
-	}
+			{
+				const mirra::decode_t &last = block.instruction[block.count - 1];
+
+				if(last.entry->mode == ADDRESS_RELATIVE) {
+					target[target_count++] = address;
+					target[target_count++] = (address + (int8_t) last.operand);
+				} else if((last.entry->handler == INSTRUCTION_HANDLER(jmp, ABSOLUTE))
+						|| (last.entry->handler == INSTRUCTION_HANDLER(jsr, ABSOLUTE))) {
+					target[target_count++] = last.operand;
+				} else if(!DECODE_TERMINAL(*last.entry)) {
+					target[target_count++] = address;
+				}
+			}
 
-	void 
-	cpu::uninitialize(void)
-	{
+			for(iter = 0; iter < target_count; ++iter) {
+				const mirra::decode_block_t &link = m_decode[target[iter] & DECODE_CACHE_MASK];
+				const mirra::mmu_page_t &page = m_mmu.page(target[iter]);
+
+				DYNAREC_EMIT_32(cursor, 0x00bb8166); // cmp word [rbx + pc], target
+				cursor -= sizeof(uint8_t);
+				DYNAREC_EMIT_32(cursor, DYNAREC_OFFSET(m_program_counter));
+				DYNAREC_EMIT_16(cursor, target[iter]);
+				DYNAREC_EMIT_16(cursor, 0x850f); // jne next
+				next = cursor;
+				DYNAREC_EMIT_32(cursor, 0);
+				DYNAREC_EMIT_16(cursor, 0xb848); // mov rax, &link
+				DYNAREC_EMIT_64(cursor, (uintptr_t) &link);
+				DYNAREC_EMIT_32(cursor, 0x00b88166); // cmp word [rax + address], target
+				cursor -= sizeof(uint8_t);
+				DYNAREC_EMIT_32(cursor, offsetof(mirra::decode_block_t, address));
+				DYNAREC_EMIT_16(cursor, target[iter]);
+				DYNAREC_EMIT_16(cursor, 0x850f); // jne exit
+				fixup[count++] = cursor;
+				DYNAREC_EMIT_32(cursor, 0);
+				DYNAREC_EMIT_16(cursor, 0x8b48); // mov rcx, [rax + native]
+				DYNAREC_EMIT_8(cursor, 0x88);
+				DYNAREC_EMIT_32(cursor, offsetof(mirra::decode_block_t, native));
+				DYNAREC_EMIT_16(cursor, 0x8548); // test rcx, rcx
+				DYNAREC_EMIT_8(cursor, 0xc9);
+				DYNAREC_EMIT_16(cursor, 0x840f); // je exit
+				fixup[count++] = cursor;
+				DYNAREC_EMIT_32(cursor, 0);
+				DYNAREC_EMIT_16(cursor, 0xba48); // mov rdx, &page
+				DYNAREC_EMIT_64(cursor, (uintptr_t) &page);
+				DYNAREC_EMIT_16(cursor, 0x8b48); // mov rdx, [rdx + read]
+				DYNAREC_EMIT_8(cursor, 0x92);
+				DYNAREC_EMIT_32(cursor, offsetof(mirra::mmu_page_t, read));
+				DYNAREC_EMIT_16(cursor, 0x8548); // test rdx, rdx
+				DYNAREC_EMIT_8(cursor, 0xd2);
+				DYNAREC_EMIT_16(cursor, 0x840f); // je exit
+				fixup[count++] = cursor;
+				DYNAREC_EMIT_32(cursor, 0);
+				DYNAREC_EMIT_16(cursor, 0x8148); // add rdx, offset
+				DYNAREC_EMIT_8(cursor, 0xc2);
+				DYNAREC_EMIT_32(cursor, MMU_PAGE_OFFSET(target[iter]));
+				DYNAREC_EMIT_16(cursor, 0x3b48); // cmp rdx, [rax + source]
+				DYNAREC_EMIT_8(cursor, 0x90);
+				DYNAREC_EMIT_32(cursor, offsetof(mirra::decode_block_t, source));
+				DYNAREC_EMIT_16(cursor, 0x850f); // jne exit
+				fixup[count++] = cursor;
+				DYNAREC_EMIT_32(cursor, 0);
+				DYNAREC_EMIT_16(cursor, 0xe1ff); // jmp rcx
+				DYNAREC_PATCH(next, cursor);
+			}
 
-		if(m_initialized) {
-			stop();
-			m_initialized = true;
+			DYNAREC_EMIT_8(cursor, 0xe9); // jmp exit
+			fixup[count++] = cursor;
+			DYNAREC_EMIT_32(cursor, 0);
+
+			for(iter = 0; iter < count; ++iter) {
+				DYNAREC_PATCH(fixup[iter], m_dynarec + DYNAREC_EXIT);
+			}
+
+			block.native = (m_dynarec + m_dynarec_offset);
+			m_dynarec_offset = (((cursor - m_dynarec) + DYNAREC_ALIGN) & ~DYNAREC_ALIGN);
 		}
+#endif // DYNAREC_SUPPORTED
+		return result;
 	}
 
-	void 
-	cpu::update(void)
+	inline void 
+	cpu::execute(
+		__in const mirra::instruction_t &entry,
+		__in uint16_t operand
+		)
 	{
-		uint8_t code;
+#if TRACE >= TRACE_PROFILE
+		uint64_t cycles = m_cycles;
+		uint8_t stack_pointer = m_stack_pointer;
+		uint16_t address = (m_program_counter - (entry.length + 1));
+#endif // TRACE >= TRACE_PROFILE
+#if TRACE >= TRACE_INSTRUCTION
+		m_trace.push({m_cycles, address, operand, (uint8_t) (&entry - INSTRUCTION_TABLE), m_accumulator,
+			m_index_x, m_index_y, flag_pack(), m_stack_pointer});
+#endif // TRACE >= TRACE_INSTRUCTION
+
+		(this->*entry.handler)(operand);
+		m_cycles += (m_boundary ? (entry.cycles + entry.boundary) : entry.cycles);
+#if TRACE >= TRACE_PROFILE
+		profile(entry, address, stack_pointer, m_cycles - cycles);
+#endif // TRACE >= TRACE_PROFILE
+	}
 
-		if(!m_initialized) {
-			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
-		}
+	template <mirra::address_t MODE> void 
+	cpu::execute_adc(
+		__in uint16_t operand
+		)
+	{
+		add(fetch<MODE>(operand));
+	}
 
-		if(!m_started) {
-			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_STOPPED);
-		}
+	template <mirra::address_t MODE> void 
+	cpu::execute_alr(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator &= WORD_LOW(operand);
+		m_carry = (BIT_CHECK(m_accumulator, FLAG_CARRY) ? 1 : 0);
+		m_accumulator >>= 1;
+		set_sign_zero(m_accumulator);
+	}
 
-		code = read(m_program_counter++);
-		switch(code) {
+	template <mirra::address_t MODE> void 
+	cpu::execute_anc(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator &= WORD_LOW(operand);
+		m_carry = (BIT_CHECK(m_accumulator, FLAG_SIGN) ? 1 : 0);
+		set_sign_zero(m_accumulator);
+	}
 
-			// TODO: process instruction at MMU[PC]
+	template <mirra::address_t MODE> void 
+	cpu::execute_and(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator &= fetch<MODE>(operand);
+		set_sign_zero(m_accumulator);
+	}
 
-			default:
-				THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_INVALID_INSTRUCTION,
-					"%x", code);
-		}
+	template <mirra::address_t MODE> void 
+	cpu::execute_ane(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = ((m_accumulator | UNSTABLE_MAGIC) & m_index_x & WORD_LOW(operand));
+		set_sign_zero(m_accumulator);
 	}
 
-	void 
-	cpu::write(
-		__in uint16_t address,
-		__in uint8_t value
+	template <mirra::address_t MODE> void 
+	cpu::execute_arr(
+		__in uint16_t operand
 		)
 	{
-		// TODO: write byte to MMU
+		m_accumulator = (((m_accumulator & WORD_LOW(operand)) >> 1) | (m_carry << FLAG_SIGN));
+		m_carry = (BIT_CHECK(m_accumulator, FLAG_OVERFLOW) ? 1 : 0);
+		m_overflow = ((m_accumulator ^ (m_accumulator << 1)) << 1);
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_asl(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address = 0;
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			value = m_accumulator;
+		} else {
+			address = indirect_address<MODE>(operand);
+			value = read<MODE>(address);
+		}
+
+		m_carry = (BIT_CHECK(value, FLAG_SIGN) ? 1 : 0);
+		value <<= 1;
+		set_sign_zero(value);
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			m_accumulator = value;
+		} else {
+			write<MODE>(address, value);
+		}
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bcc(
+		__in uint16_t operand
+		)
+	{
+		branch(!m_carry, operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bcs(
+		__in uint16_t operand
+		)
+	{
+		branch(m_carry, operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_beq(
+		__in uint16_t operand
+		)
+	{
+		branch(!m_zero, operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bit(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+
+		value = fetch<MODE>(operand);
+		m_overflow = (value << 1);
+		m_sign = value;
+		m_zero = (m_accumulator & value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bmi(
+		__in uint16_t operand
+		)
+	{
+		branch(BIT_CHECK(m_sign, FLAG_SIGN), operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bne(
+		__in uint16_t operand
+		)
+	{
+		branch(m_zero, operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bpl(
+		__in uint16_t operand
+		)
+	{
+		branch(!BIT_CHECK(m_sign, FLAG_SIGN), operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_brk(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+
+		value = flag_pack();
+		BIT_SET(value, FLAG_INTERRUPT_ACTIVE);
+		BIT_SET(value, FLAG_UNUSED_1);
+		push_word(m_program_counter + 1);
+		push(value);
+		m_flag.interrupt_disable = true;
+		m_program_counter = read_word(INTERRUPT_IRQ);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bvc(
+		__in uint16_t operand
+		)
+	{
+		branch(!BIT_CHECK(m_overflow, FLAG_SIGN), operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_bvs(
+		__in uint16_t operand
+		)
+	{
+		branch(BIT_CHECK(m_overflow, FLAG_SIGN), operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_clc(
+		__in uint16_t operand
+		)
+	{
+		m_carry = 0;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_cld(
+		__in uint16_t operand
+		)
+	{
+		m_flag.decimal = false;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_cli(
+		__in uint16_t operand
+		)
+	{
+		m_flag.interrupt_disable = false;
+		interrupt_poll(true);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_clv(
+		__in uint16_t operand
+		)
+	{
+		m_overflow = 0;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_cmp(
+		__in uint16_t operand
+		)
+	{
+		compare(m_accumulator, fetch<MODE>(operand));
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_cpx(
+		__in uint16_t operand
+		)
+	{
+		compare(m_index_x, fetch<MODE>(operand));
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_cpy(
+		__in uint16_t operand
+		)
+	{
+		compare(m_index_y, fetch<MODE>(operand));
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_dcp(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = (read<MODE>(address) - 1);
+		write<MODE>(address, value);
+		compare(m_accumulator, value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_dec(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = (read<MODE>(address) - 1);
+		set_sign_zero(value);
+		write<MODE>(address, value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_dex(
+		__in uint16_t operand
+		)
+	{
+		set_sign_zero(--m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_dey(
+		__in uint16_t operand
+		)
+	{
+		set_sign_zero(--m_index_y);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_eor(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator ^= fetch<MODE>(operand);
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_inc(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = (read<MODE>(address) + 1);
+		set_sign_zero(value);
+		write<MODE>(address, value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_inx(
+		__in uint16_t operand
+		)
+	{
+		set_sign_zero(++m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_iny(
+		__in uint16_t operand
+		)
+	{
+		set_sign_zero(++m_index_y);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_isc(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = (read<MODE>(address) + 1);
+		write<MODE>(address, value);
+		add(~value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_jam(
+		__in uint16_t operand
+		)
+	{
+		--m_program_counter;
+		m_halted = true;
+		raise(CPU_EVENT_HALT);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_jmp(
+		__in uint16_t operand
+		)
+	{
+		m_program_counter = indirect_address<MODE>(operand);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_jsr(
+		__in uint16_t operand
+		)
+	{
+		push_word(m_program_counter - 1);
+		m_program_counter = operand;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_las(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = (fetch<MODE>(operand) & m_stack_pointer);
+		m_index_x = m_accumulator;
+		m_stack_pointer = m_accumulator;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_lax(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = fetch<MODE>(operand);
+		m_index_x = m_accumulator;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_lda(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = fetch<MODE>(operand);
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_ldx(
+		__in uint16_t operand
+		)
+	{
+		m_index_x = fetch<MODE>(operand);
+		set_sign_zero(m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_ldy(
+		__in uint16_t operand
+		)
+	{
+		m_index_y = fetch<MODE>(operand);
+		set_sign_zero(m_index_y);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_lsr(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address = 0;
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			value = m_accumulator;
+		} else {
+			address = indirect_address<MODE>(operand);
+			value = read<MODE>(address);
+		}
+
+		m_carry = (BIT_CHECK(value, FLAG_CARRY) ? 1 : 0);
+		value >>= 1;
+		set_sign_zero(value);
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			m_accumulator = value;
+		} else {
+			write<MODE>(address, value);
+		}
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_lxa(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = ((m_accumulator | UNSTABLE_MAGIC) & WORD_LOW(operand));
+		m_index_x = m_accumulator;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_nop(
+		__in uint16_t operand
+		)
+	{
+
+		if((MODE != ADDRESS_IMMEDIATE) && (MODE != ADDRESS_IMPLIED)) {
+			fetch<MODE>(operand);
+		}
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_ora(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator |= fetch<MODE>(operand);
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_pha(
+		__in uint16_t operand
+		)
+	{
+		push(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_php(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+
+		value = flag_pack();
+		BIT_SET(value, FLAG_INTERRUPT_ACTIVE);
+		BIT_SET(value, FLAG_UNUSED_1);
+		push(value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_pla(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = pop();
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_plp(
+		__in uint16_t operand
+		)
+	{
+		flag_unpack(pop());
+		interrupt_poll(true);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_rla(
+		__in uint16_t operand
+		)
+	{
+		uint8_t carry, value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = read<MODE>(address);
+		carry = m_carry;
+		m_carry = (BIT_CHECK(value, FLAG_SIGN) ? 1 : 0);
+		value = ((value << 1) | carry);
+		write<MODE>(address, value);
+		m_accumulator &= value;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_rol(
+		__in uint16_t operand
+		)
+	{
+		uint8_t carry, value;
+		uint16_t address = 0;
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			value = m_accumulator;
+		} else {
+			address = indirect_address<MODE>(operand);
+			value = read<MODE>(address);
+		}
+
+		carry = m_carry;
+		m_carry = (BIT_CHECK(value, FLAG_SIGN) ? 1 : 0);
+		value = ((value << 1) | carry);
+		set_sign_zero(value);
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			m_accumulator = value;
+		} else {
+			write<MODE>(address, value);
+		}
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_ror(
+		__in uint16_t operand
+		)
+	{
+		uint8_t carry, value;
+		uint16_t address = 0;
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			value = m_accumulator;
+		} else {
+			address = indirect_address<MODE>(operand);
+			value = read<MODE>(address);
+		}
+
+		carry = m_carry;
+		m_carry = (BIT_CHECK(value, FLAG_CARRY) ? 1 : 0);
+		value = ((value >> 1) | (carry << FLAG_SIGN));
+		set_sign_zero(value);
+
+		if(MODE == ADDRESS_ACCUMULATOR) {
+			m_accumulator = value;
+		} else {
+			write<MODE>(address, value);
+		}
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_rra(
+		__in uint16_t operand
+		)
+	{
+		uint8_t carry, value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = read<MODE>(address);
+		carry = m_carry;
+		m_carry = (BIT_CHECK(value, FLAG_CARRY) ? 1 : 0);
+		value = ((value >> 1) | (carry << FLAG_SIGN));
+		write<MODE>(address, value);
+		add(value);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_rti(
+		__in uint16_t operand
+		)
+	{
+		flag_unpack(pop());
+		m_program_counter = pop_word();
+		interrupt_poll(false);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_rts(
+		__in uint16_t operand
+		)
+	{
+		m_program_counter = (pop_word() + 1);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sax(
+		__in uint16_t operand
+		)
+	{
+		write<MODE>(indirect_address<MODE>(operand), m_accumulator & m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sbc(
+		__in uint16_t operand
+		)
+	{
+		add(~fetch<MODE>(operand));
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sbx(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+
+		value = (m_accumulator & m_index_x);
+		compare(value, WORD_LOW(operand));
+		m_index_x = (value - WORD_LOW(operand));
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sec(
+		__in uint16_t operand
+		)
+	{
+		m_carry = 1;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sed(
+		__in uint16_t operand
+		)
+	{
+		m_flag.decimal = true;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sei(
+		__in uint16_t operand
+		)
+	{
+		m_flag.interrupt_disable = true;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sha(
+		__in uint16_t operand
+		)
+	{
+		store_high(indirect_address<MODE>(operand), m_index_y, m_accumulator & m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_shx(
+		__in uint16_t operand
+		)
+	{
+		store_high(indirect_address<MODE>(operand), m_index_y, m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_shy(
+		__in uint16_t operand
+		)
+	{
+		store_high(indirect_address<MODE>(operand), m_index_x, m_index_y);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_slo(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = read<MODE>(address);
+		m_carry = (BIT_CHECK(value, FLAG_SIGN) ? 1 : 0);
+		value <<= 1;
+		write<MODE>(address, value);
+		m_accumulator |= value;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sre(
+		__in uint16_t operand
+		)
+	{
+		uint8_t value;
+		uint16_t address;
+
+		address = indirect_address<MODE>(operand);
+		value = read<MODE>(address);
+		m_carry = (BIT_CHECK(value, FLAG_CARRY) ? 1 : 0);
+		value >>= 1;
+		write<MODE>(address, value);
+		m_accumulator ^= value;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sta(
+		__in uint16_t operand
+		)
+	{
+		write<MODE>(indirect_address<MODE>(operand), m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_stx(
+		__in uint16_t operand
+		)
+	{
+		write<MODE>(indirect_address<MODE>(operand), m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_sty(
+		__in uint16_t operand
+		)
+	{
+		write<MODE>(indirect_address<MODE>(operand), m_index_y);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_tas(
+		__in uint16_t operand
+		)
+	{
+		m_stack_pointer = (m_accumulator & m_index_x);
+		store_high(indirect_address<MODE>(operand), m_index_y, m_stack_pointer);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_tax(
+		__in uint16_t operand
+		)
+	{
+		m_index_x = m_accumulator;
+		set_sign_zero(m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_tay(
+		__in uint16_t operand
+		)
+	{
+		m_index_y = m_accumulator;
+		set_sign_zero(m_index_y);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_tsx(
+		__in uint16_t operand
+		)
+	{
+		m_index_x = m_stack_pointer;
+		set_sign_zero(m_index_x);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_txa(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = m_index_x;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_txs(
+		__in uint16_t operand
+		)
+	{
+		m_stack_pointer = m_index_x;
+	}
+
+	template <mirra::address_t MODE> void 
+	cpu::execute_tya(
+		__in uint16_t operand
+		)
+	{
+		m_accumulator = m_index_y;
+		set_sign_zero(m_accumulator);
+	}
+
+	template <mirra::address_t MODE> uint8_t 
+	cpu::fetch(
+		__in uint16_t operand
+		)
+	{
+		uint8_t result;
+
+		switch(MODE) {
+			case ADDRESS_ACCUMULATOR:
+				result = m_accumulator;
+				break;
+			case ADDRESS_IMMEDIATE:
+				result = WORD_LOW(operand);
+				break;
+			default:
+				result = read<MODE>(indirect_address<MODE>(operand));
+				break;
+		}
+
+		return result;
+	}
+
+	uint8_t 
+	cpu::flag_pack(void)
+	{
+		return ((m_carry << FLAG_CARRY)
+			| ((m_zero ? 0 : 1) << FLAG_ZERO)
+			| (m_flag.interrupt_disable << FLAG_INTERRUPT_DISABLE)
+			| (m_flag.decimal << FLAG_DECIMAL)
+			| (m_flag.interrupt_active << FLAG_INTERRUPT_ACTIVE)
+			| (m_flag.unused_1 << FLAG_UNUSED_1)
+			| ((BIT_CHECK(m_overflow, FLAG_SIGN) ? 1 : 0) << FLAG_OVERFLOW)
+			| (m_sign & (1 << FLAG_SIGN)));
+	}
+
+	void 
+	cpu::flag_unpack(
+		__in uint8_t value
+		)
+	{
+		m_carry = (BIT_CHECK(value, FLAG_CARRY) ? 1 : 0);
+		m_zero = (BIT_CHECK(value, FLAG_ZERO) ? 0 : 1);
+		m_flag.interrupt_disable = (BIT_CHECK(value, FLAG_INTERRUPT_DISABLE) ? 1 : 0);
+		m_flag.decimal = (BIT_CHECK(value, FLAG_DECIMAL) ? 1 : 0);
+		m_overflow = (value << 1);
+		m_sign = value;
+	}
+
+	void 
+	cpu::idle(
+		__in uint16_t address,
+		__in uint16_t branch
+		)
+	{
+		uint8_t flag;
+		uint64_t period;
+
+		flag = flag_pack();
+
+		if(!m_idle.valid || (m_idle.address != address) || (m_idle.branch != branch)
+				|| (m_idle.generation != m_mmu.generation())) {
+			m_idle.address = address;
+			m_idle.branch = branch;
+			m_idle.generation = m_mmu.generation();
+			m_idle.pure = idle_pure(address, branch);
+		} else if(m_idle.pure && (m_idle.accumulator == m_accumulator) && (m_idle.flag == flag)
+				&& (m_idle.index_x == m_index_x) && (m_idle.index_y == m_index_y)
+				&& (m_idle.stack_pointer == m_stack_pointer)) {
+			period = (m_cycles - m_idle.cycles);
+
+			if(period && (m_cycles < m_cycles_limit)) {
+				m_cycles += (((m_cycles_limit - m_cycles) / period) * period);
+			}
+		}
+
+		m_idle.accumulator = m_accumulator;
+		m_idle.cycles = m_cycles;
+		m_idle.flag = flag;
+		m_idle.index_x = m_index_x;
+		m_idle.index_y = m_index_y;
+		m_idle.stack_pointer = m_stack_pointer;
+		m_idle.valid = true;
+	}
+
+	bool 
+	cpu::idle_pure(
+		__in uint16_t address,
+		__in uint16_t branch
+		)
+	{
+		uint16_t operand;
+		bool result = true, status;
+		const mirra::instruction_t *entry;
+
+		entry = &INSTRUCTION_TABLE[read(address)];
+		status = ((branch == (address + ADDRESS_LENGTH(ADDRESS_ABSOLUTE) + 1))
+			&& ((entry->handler == INSTRUCTION_HANDLER(bit, ABSOLUTE))
+				|| (entry->handler == INSTRUCTION_HANDLER(lda, ABSOLUTE))
+				|| (entry->handler == INSTRUCTION_HANDLER(ldx, ABSOLUTE))
+				|| (entry->handler == INSTRUCTION_HANDLER(ldy, ABSOLUTE)))
+			&& ((INSTRUCTION_TABLE[read(branch)].handler == INSTRUCTION_HANDLER(bmi, RELATIVE))
+				|| (INSTRUCTION_TABLE[read(branch)].handler == INSTRUCTION_HANDLER(bpl, RELATIVE))));
+
+		while(result && (address < branch)) {
+			entry = &INSTRUCTION_TABLE[read(address)];
+			result = (IDLE_PURE(entry, and)
+				|| (entry->handler == INSTRUCTION_HANDLER(bcc, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(bcs, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(beq, RELATIVE))
+				|| IDLE_PURE(entry, bit)
+				|| (entry->handler == INSTRUCTION_HANDLER(bmi, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(bne, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(bpl, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(bvc, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(bvs, RELATIVE))
+				|| (entry->handler == INSTRUCTION_HANDLER(clc, IMPLIED))
+				|| (entry->handler == INSTRUCTION_HANDLER(clv, IMPLIED))
+				|| IDLE_PURE(entry, cmp)
+				|| IDLE_PURE(entry, cpx)
+				|| IDLE_PURE(entry, cpy)
+				|| IDLE_PURE(entry, eor)
+				|| IDLE_PURE(entry, lda)
+				|| IDLE_PURE(entry, ldx)
+				|| IDLE_PURE(entry, ldy)
+				|| (entry->handler == INSTRUCTION_HANDLER(nop, IMPLIED))
+				|| IDLE_PURE(entry, ora)
+				|| (entry->handler == INSTRUCTION_HANDLER(sec, IMPLIED))
+				|| (entry->handler == INSTRUCTION_HANDLER(tax, IMPLIED))
+				|| (entry->handler == INSTRUCTION_HANDLER(tay, IMPLIED))
+				|| (entry->handler == INSTRUCTION_HANDLER(txa, IMPLIED))
+				|| (entry->handler == INSTRUCTION_HANDLER(tya, IMPLIED)));
+
+			if(result) {
+
+				switch(entry->mode) {
+					case ADDRESS_ABSOLUTE:
+						operand = read_word(address + 1);
+						result = (m_mmu.page(operand).read
+							|| (status && ((operand & IDLE_PPU_STATUS_MASK) == IDLE_PPU_STATUS)));
+						break;
+					case ADDRESS_IMMEDIATE:
+					case ADDRESS_IMPLIED:
+					case ADDRESS_RELATIVE:
+					case ADDRESS_ZERO_PAGE:
+						break;
+					default:
+						result = false;
+						break;
+				}
+			}
+
+			address += (entry->length + 1);
+		}
+
+		return (result && (address == branch));
+	}
+
+	template <mirra::address_t MODE> inline uint16_t 
+	cpu::indirect_address(
+		__in uint16_t address
+		)
+	{
+		uint16_t result = 0;
+
+		switch(MODE) {
+			case ADDRESS_ABSOLUTE:
+				result = address;
+				break;
+			case ADDRESS_ABSOLUTE_X:
+				result = (address + m_index_x);
+				m_boundary = ((WORD_LOW(address) + m_index_x) > UINT8_MAX);
+				break;
+			case ADDRESS_ABSOLUTE_Y:
+				result = (address + m_index_y);
+				m_boundary = ((WORD_LOW(address) + m_index_y) > UINT8_MAX);
+				break;
+			case ADDRESS_INDIRECT:
+				result = WORD(read(address), read((address & (UINT16_MAX ^ UINT8_MAX)) | WORD_LOW(address + 1)));
+				break;
+			case ADDRESS_INDIRECT_X:
+				address = WORD_LOW(address + m_index_x);
+				result = WORD(m_ram[address], m_ram[WORD_LOW(address + 1)]);
+				break;
+			case ADDRESS_INDIRECT_Y:
+				address = WORD_LOW(address);
+				result = WORD(m_ram[address], m_ram[WORD_LOW(address + 1)]);
+				m_boundary = ((WORD_LOW(result) + m_index_y) > UINT8_MAX);
+				result += m_index_y;
+				break;
+			case ADDRESS_ZERO_PAGE:
+				result = WORD_LOW(address);
+				break;
+			case ADDRESS_ZERO_PAGE_X:
+				result = WORD_LOW(address + m_index_x);
+				break;
+			case ADDRESS_ZERO_PAGE_Y:
+				result = WORD_LOW(address + m_index_y);
+				break;
+			default:
+				THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_INVALID_INDIRECT,
+					"%s (%x)", ADDRESS_STRING(MODE), MODE);
+		}
+
+		return result;
+	}
+
+	void 
+	cpu::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		mirra::parameter_t::const_iterator iter;
+		mirra::object_parameter_t::const_iterator attribute_iter;
+
+		if(m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_INITIALIZED);
+		}
+
+		m_engine = ENGINE_TABLE;
+
+		iter = parameter.find(OBJECT_CPU);
+		if(iter != parameter.end()) {
+
+			attribute_iter = iter->second.find(CPU_PARAMETER_ENGINE);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_UNSIGNED)
+						|| (attribute_iter->second.data.uvalue > ENGINE_MAX)) {
+					THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s <= %u)", CPU_PARAMETER_STRING(CPU_PARAMETER_ENGINE),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_UNSIGNED), ENGINE_MAX);
+				}
+
+				m_engine = (mirra::engine_t) attribute_iter->second.data.uvalue;
+			}
+		}
+
+		m_decode.resize(DECODE_CACHE_SIZE);
+		std::memset(m_decode_page, 0, sizeof(m_decode_page));
+
+		if(m_engine == ENGINE_DYNAREC) {
+			dynarec_allocate();
+		}
+		m_ram = m_mmu.ram();
+		m_mmu.attach(this);
+		m_initialized = true;
+	}
+
+	const mirra::instruction_t &
+	cpu::instruction(
+		__in uint8_t opcode
+		)
+	{
+		return INSTRUCTION_TABLE[opcode];
+	}
+
+	mirra::cpu_event_t 
+	cpu::interpret(
+		__in uint32_t cycles
+		)
+	{
+		m_cycles_target = (m_cycles + cycles);
+		m_idle.valid = false;
+
+		if(m_halted) {
+			raise(CPU_EVENT_HALT);
+		}
+
+		while((m_event == CPU_EVENT_NONE) && (m_cycles < m_cycles_target)) {
+
+			if(m_interrupt) {
+				interrupt();
+
+				if(m_event != CPU_EVENT_NONE) {
+					break;
+				}
+			}
+
+			m_cycles_limit = m_cycles_target;
+
+			if(!m_breakpoint.empty()) {
+				interpret_breakpoint();
+			} else {
+
+				switch(m_engine) {
+					case ENGINE_DECODE:
+						interpret_decode();
+						break;
+					case ENGINE_DYNAREC:
+						interpret_dynarec();
+						break;
+					case ENGINE_THREADED:
+						interpret_threaded();
+						break;
+					default:
+						interpret_table();
+						break;
+				}
+			}
+		}
+
+		return event();
+	}
+
+	void 
+	cpu::interpret_breakpoint(void)
+	{
+
+		do {
+			step(INSTRUCTION_TABLE[read(m_program_counter++)]);
+
+			if(m_breakpoint.find(m_program_counter) != m_breakpoint.end()) {
+				raise(CPU_EVENT_BREAKPOINT);
+			}
+		} while(m_cycles < m_cycles_limit);
+	}
+
+	void 
+	cpu::interpret_decode(void)
+	{
+
+		do {
+			const mirra::decode_block_t &block = decode(m_program_counter);
+
+			if(!block.count) {
+				step(INSTRUCTION_TABLE[read(m_program_counter++)]);
+			} else {
+				step_block(block);
+			}
+		} while(m_cycles < m_cycles_limit);
+	}
+
+	void 
+	cpu::interpret_dynarec(void)
+	{
+
+		do {
+			mirra::decode_block_t &block = decode(m_program_counter);
+
+			if(!block.count) {
+				step(INSTRUCTION_TABLE[read(m_program_counter++)]);
+			} else if(block.native
+					|| ((++block.hits >= DYNAREC_THRESHOLD) && dynarec_translate(block))) {
+				((mirra::dynarec_cb) (m_dynarec + DYNAREC_ENTER))(this, block.native);
+			} else {
+				step_block(block);
+			}
+		} while(m_cycles < m_cycles_limit);
+	}
+
+	void 
+	cpu::interpret_table(void)
+	{
+
+		do {
+			step(INSTRUCTION_TABLE[read(m_program_counter++)]);
+		} while(m_cycles < m_cycles_limit);
+	}
+
+	void 
+	cpu::interpret_threaded(void)
+	{
+#ifdef __GNUC__
+		static void *label[] = {
+			INSTRUCTION_EACH(INSTRUCTION_LABEL)
+			};
+
+		goto *label[read(m_program_counter++)];
+		INSTRUCTION_EACH(INSTRUCTION_THREAD)
+#else
+		interpret_table();
+#endif // __GNUC__
+	}
+
+	void 
+	cpu::interrupt(void)
+	{
+
+		if(m_interrupt_delay) {
+			m_interrupt_delay = false;
+			step(INSTRUCTION_TABLE[read(m_program_counter++)]);
+
+			if(m_halted) {
+				return;
+			}
+		}
+
+		if(BIT_CHECK(m_interrupt, INTERRUPT_LINE_NMI)) {
+			BIT_CLEAR(m_interrupt, INTERRUPT_LINE_NMI);
+			nmi();
+		} else if((m_interrupt & INTERRUPT_IRQ_MASK) && !m_flag.interrupt_disable) {
+			irq();
+		}
+	}
+
+	void 
+	cpu::interrupt_assert(
+		__in mirra::interrupt_line_t line
+		)
+	{
+
+		if((line != INTERRUPT_LINE_NMI) || !BIT_CHECK(m_interrupt_line, INTERRUPT_LINE_NMI)) {
+			BIT_SET(m_interrupt, line);
+			m_cycles_limit = m_cycles;
+		}
+
+		BIT_SET(m_interrupt_line, line);
+	}
+
+	void 
+	cpu::interrupt_poll(
+		__in bool delay
+		)
+	{
+
+		if(m_interrupt & INTERRUPT_IRQ_MASK) {
+			m_interrupt_delay = delay;
+			m_cycles_limit = m_cycles;
+		}
+	}
+
+	void 
+	cpu::interrupt_release(
+		__in mirra::interrupt_line_t line
+		)
+	{
+		BIT_CLEAR(m_interrupt_line, line);
+
+		if(line != INTERRUPT_LINE_NMI) {
+			BIT_CLEAR(m_interrupt, line);
+		}
+	}
+
+	void 
+	cpu::invalidate(
+		__in uint16_t address
+		)
+	{
+		uint32_t iter;
+
+		if(!MMU_CODE_CHECK(m_decode_page, MMU_PAGE(address))) {
+			return;
+		}
+
+		m_decode_page[MMU_PAGE(address) >> MMU_CODE_WIDTH] &= ~(1U << (MMU_PAGE(address) & MMU_CODE_MASK));
+		m_idle.pure = false;
+		m_idle.valid = false;
+
+		for(iter = address; iter < (uint32_t) (address + MMU_PAGE_SIZE); ++iter) {
+			mirra::decode_block_t &block = m_decode[iter & DECODE_CACHE_MASK];
+
+			if(block.source && (block.address == iter)) {
+				block.source = nullptr;
+				block.count = 0;
+				block.hits = 0;
+				block.native = nullptr;
+			}
+		}
+	}
+
+	void 
+	cpu::irq(void)
+	{
+		uint8_t value;
+#if TRACE >= TRACE_PROFILE
+		uint8_t stack_pointer = m_stack_pointer;
+#endif // TRACE >= TRACE_PROFILE
+
+		value = flag_pack();
+		BIT_CLEAR(value, FLAG_INTERRUPT_ACTIVE);
+		BIT_SET(value, FLAG_UNUSED_1);
+		m_idle.valid = false;
+		push_word(m_program_counter);
+		push(value);
+		m_flag.interrupt_disable = true;
+		m_program_counter = read_word(INTERRUPT_IRQ);
+		m_cycles += INTERRUPT_CYCLES;
+		raise(CPU_EVENT_INTERRUPT);
+#if TRACE >= TRACE_PROFILE
+		profile_call(m_program_counter, stack_pointer);
+#endif // TRACE >= TRACE_PROFILE
+	}
+
+	bool 
+	cpu::is_halted(void)
+	{
+		return m_halted;
+	}
+
+	bool 
+	cpu::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	cpu::is_started(void)
+	{
+		return m_started;
+	}
+
+	void 
+	cpu::limit(
+		__in uint64_t cycle
+		)
+	{
+
+		if(cycle < m_cycles_target) {
+			m_cycles_target = cycle;
+		}
+
+		if(cycle < m_cycles_limit) {
+			m_cycles_limit = cycle;
+		}
+	}
+
+	void 
+	cpu::nmi(void)
+	{
+		uint8_t value;
+#if TRACE >= TRACE_PROFILE
+		uint8_t stack_pointer = m_stack_pointer;
+#endif // TRACE >= TRACE_PROFILE
+
+		value = flag_pack();
+		BIT_CLEAR(value, FLAG_INTERRUPT_ACTIVE);
+		BIT_SET(value, FLAG_UNUSED_1);
+		m_idle.valid = false;
+		push_word(m_program_counter);
+		push(value);
+		m_flag.interrupt_disable = true;
+		m_program_counter = read_word(INTERRUPT_NMI);
+		m_cycles += INTERRUPT_CYCLES;
+		raise(CPU_EVENT_INTERRUPT);
+#if TRACE >= TRACE_PROFILE
+		profile_call(m_program_counter, stack_pointer);
+#endif // TRACE >= TRACE_PROFILE
+	}
+
+	uint8_t 
+	cpu::pop(void)
+	{
+		return m_ram[++m_stack_pointer + STACK_BASE];
+	}
+
+	uint16_t 
+	cpu::pop_word(void)
+	{
+		uint8_t low;
+
+		low = pop();
+
+		return WORD(low, pop());
+	}
+
+#if TRACE >= TRACE_PROFILE
+	void 
+	cpu::profile(
+		__in const mirra::instruction_t &entry,
+		__in uint16_t address,
+		__in uint8_t stack_pointer,
+		__in uint64_t cycles
+		)
+	{
+		mirra::profile_t &record = m_profile[PROFILE_KEY(m_mmu.bank(address), address)];
+		mirra::profile_t &total = m_profile_frame[m_profile_call.back().first].total;
+
+		++record.count;
+		record.cycles += cycles;
+		++total.count;
+		total.cycles += cycles;
+
+		if((entry.handler == INSTRUCTION_HANDLER(brk, IMPLIED))
+				|| (entry.handler == INSTRUCTION_HANDLER(jsr, ABSOLUTE))) {
+			profile_call(m_program_counter, stack_pointer);
+		} else if((entry.handler == INSTRUCTION_HANDLER(rti, IMPLIED))
+				|| (entry.handler == INSTRUCTION_HANDLER(rts, IMPLIED))) {
+			profile_return(m_stack_pointer);
+		}
+	}
+
+	void 
+	cpu::profile_call(
+		__in uint16_t address,
+		__in uint8_t stack_pointer
+		)
+	{
+		uint32_t index, key = PROFILE_KEY(m_mmu.bank(address), address);
+		std::map<uint32_t, uint32_t>::iterator iter;
+
+		profile_return(stack_pointer);
+		index = m_profile_call.back().first;
+
+		iter = m_profile_frame[index].child.find(key);
+		if(iter == m_profile_frame[index].child.end()) {
+			m_profile_frame.push_back({index, key, {0, 0}});
+			iter = m_profile_frame[index].child.insert(std::make_pair(key, m_profile_frame.size() - 1)).first;
+		}
+
+		m_profile_call.push_back(std::make_pair(iter->second, stack_pointer));
+	}
+
+	void 
+	cpu::profile_clear(void)
+	{
+		m_profile.clear();
+		m_profile_call.clear();
+		m_profile_frame.clear();
+		m_profile_frame.push_back({0, PROFILE_KEY_ROOT, {0, 0}});
+		m_profile_call.push_back(std::make_pair(0, 0));
+	}
+
+	void 
+	cpu::profile_export(
+		__in const std::string &path,
+		__in_opt bool collapsed
+		)
+	{
+		std::string stack;
+		std::ofstream file;
+		uint64_t cycles = 0;
+		uint32_t index, parent;
+		std::map<uint32_t, mirra::profile_t> bank, subroutine;
+		std::map<uint32_t, mirra::profile_t>::iterator iter;
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		file.open(path.c_str(), std::ios::out | std::ios::trunc);
+		if(!file) {
+			THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_PROFILE_EXPORT,
+				"%s", path.c_str());
+		}
+
+		if(collapsed) {
+
+			for(index = 0; index < m_profile_frame.size(); ++index) {
+				const mirra::profile_frame_t &frame = m_profile_frame[index];
+
+				if(frame.total.cycles) {
+					stack = profile_name(frame.key);
+
+					for(parent = index; parent; ) {
+						parent = m_profile_frame[parent].parent;
+						stack = (profile_name(m_profile_frame[parent].key) + ";" + stack);
+					}
+
+					file << stack << " " << frame.total.cycles << std::endl;
+				}
+			}
+		} else {
+
+			for(iter = m_profile.begin(); iter != m_profile.end(); ++iter) {
+				mirra::profile_t &entry = bank[PROFILE_KEY_BANK(iter->first)];
+
+				entry.count += iter->second.count;
+				entry.cycles += iter->second.cycles;
+				cycles += iter->second.cycles;
+			}
+
+			for(index = 0; index < m_profile_frame.size(); ++index) {
+				const mirra::profile_frame_t &frame = m_profile_frame[index];
+				mirra::profile_t &entry = subroutine[frame.key];
+
+				entry.count += frame.total.count;
+				entry.cycles += frame.total.cycles;
+			}
+
+			profile_section(file, "ADDRESS", m_profile, cycles);
+			profile_section(file, "BANK", bank, cycles, true);
+			profile_section(file, "SUBROUTINE", subroutine, cycles);
+		}
+
+		if(!file) {
+			THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_PROFILE_EXPORT,
+				"%s", path.c_str());
+		}
+	}
+
+	std::string 
+	cpu::profile_name(
+		__in uint32_t key
+		)
+	{
+		std::stringstream result;
+
+		if(key == PROFILE_KEY_ROOT) {
+			result << PROFILE_ROOT;
+		} else {
+			result << SCALAR_AS_HEX(uint16_t, PROFILE_KEY_BANK(key))
+				<< ":" << SCALAR_AS_HEX(uint16_t, PROFILE_KEY_ADDRESS(key));
+		}
+
+		return result.str();
+	}
+
+	void 
+	cpu::profile_return(
+		__in uint8_t stack_pointer
+		)
+	{
+
+		while((m_profile_call.size() > 1) && (m_profile_call.back().second <= stack_pointer)) {
+			m_profile_call.pop_back();
+		}
+	}
+
+	void 
+	cpu::profile_section(
+		__in std::ofstream &file,
+		__in const std::string &title,
+		__in const std::map<uint32_t, mirra::profile_t> &section,
+		__in uint64_t cycles,
+		__in_opt bool bank
+		)
+	{
+		std::vector<std::pair<uint64_t, uint32_t>> order;
+		std::vector<std::pair<uint64_t, uint32_t>>::iterator order_iter;
+		std::map<uint32_t, mirra::profile_t>::const_iterator iter;
+
+		for(iter = section.begin(); iter != section.end(); ++iter) {
+			order.push_back(std::make_pair(iter->second.cycles, iter->first));
+		}
+
+		std::sort(order.begin(), order.end(), std::greater<std::pair<uint64_t, uint32_t>>());
+		file << "# " << title << " INSTRUCTIONS CYCLES PERCENT" << std::endl;
+
+		for(order_iter = order.begin(); order_iter != order.end(); ++order_iter) {
+			iter = section.find(order_iter->second);
+
+			if(bank) {
+				file << SCALAR_AS_HEX(uint16_t, iter->first);
+			} else {
+				file << profile_name(iter->first);
+			}
+
+			file << " " << iter->second.count << " " << iter->second.cycles << " " << std::fixed
+				<< std::setprecision(2) << (cycles ? ((iter->second.cycles * 100.0) / cycles) : 0.0)
+				<< std::endl;
+		}
+
+		file << std::endl;
+	}
+#endif // TRACE >= TRACE_PROFILE
+
+	void 
+	cpu::push(
+		__in uint8_t value
+		)
+	{
+		m_ram[m_stack_pointer-- + STACK_BASE] = value;
+	}
+
+	void 
+	cpu::push_word(
+		__in uint16_t value
+		)
+	{
+		push(WORD_HIGH(value));
+		push(WORD_LOW(value));
+	}
+
+	void 
+	cpu::raise(
+		__in mirra::cpu_event_t event
+		)
+	{
+		m_event = event;
+		m_cycles_limit = m_cycles;
+	}
+
+	inline uint8_t 
+	cpu::read(
+		__in uint16_t address
+		)
+	{
+		return m_mmu.read(address);
+	}
+
+	template <mirra::address_t MODE> inline uint8_t 
+	cpu::read(
+		__in uint16_t address
+		)
+	{
+		return (ZERO_PAGE_MODE(MODE) ? m_ram[address] : read(address));
+	}
+
+	uint16_t 
+	cpu::read_word(
+		__in uint16_t address
+		)
+	{
+		uint8_t low;
+
+		low = read(address);
+
+		return WORD(low, read(address + 1));
+	}
+
+	template <typename T> std::string 
+	cpu::register_as_string(
+		__in T value,
+		__in_opt bool verbose,
+		__in_opt bool flag
+		)
+	{
+		int iter;
+		std::stringstream result;
+
+		result << SCALAR_AS_HEX(T, value);
+
+		if(verbose) {
+			result << " (";
+
+			for(iter = ((CHAR_BIT * sizeof(T)) - 1); iter >= 0; --iter) {
+
+				if(flag && (iter <= FLAG_MAX)) {
+					result << (BIT_CHECK(value, iter) ? FLAG_STRING(iter) : FLAG_UNDEFINED);
+				} else {
+					result << (BIT_CHECK(value, iter) ? "1" : "0");
+				}
+			}
+
+			result << ")";
+		}
+
+		return result.str();
+	}
+
+	mirra::cpu_register_t 
+	cpu::registers(void)
+	{
+		mirra::cpu_register_t result;
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		result.accumulator = m_accumulator;
+		result.flag = flag_pack();
+		result.index_x = m_index_x;
+		result.index_y = m_index_y;
+		result.program_counter = m_program_counter;
+		result.stack_pointer = m_stack_pointer;
+
+		return result;
+	}
+
+	void 
+	cpu::registers(
+		__in const mirra::cpu_register_t &value
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(!m_started) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_STOPPED);
+		}
+
+		m_accumulator = value.accumulator;
+		flag_unpack(value.flag);
+		m_index_x = value.index_x;
+		m_index_y = value.index_y;
+		m_program_counter = value.program_counter;
+		m_stack_pointer = value.stack_pointer;
+		m_idle.valid = false;
+		m_interrupt_delay = false;
+	}
+
+	void 
+	cpu::reset(void)
+	{
+		clear();
+		m_program_counter = read_word(INTERRUPT_RESET);
+	}
+
+	mirra::cpu_event_t 
+	cpu::run_for(
+		__in uint32_t cycles
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(!m_started) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_STOPPED);
+		}
+
+		return interpret(cycles);
+	}
+
+	mirra::cpu_event_t 
+	cpu::run_until(
+		__in mirra::cpu_event_t event
+		)
+	{
+		mirra::cpu_event_t result;
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(!m_started) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_STOPPED);
+		}
+
+		if((event == CPU_EVENT_FRAME) || (event > CPU_EVENT_MAX)) {
+			THROW_MIRRA_CPU_EXCEPTION_FORMAT(MIRRA_CPU_EXCEPTION_INVALID_EVENT,
+				"%s (%x)", CPU_EVENT_STRING(event), event);
+		}
+
+		do {
+			result = interpret(CPU_SLICE_CYCLES);
+		} while((result != event) && (result != CPU_EVENT_BREAKPOINT) && (result != CPU_EVENT_HALT));
+
+		return result;
+	}
+
+	void 
+	cpu::set_sign_zero(
+		__in uint8_t value
+		)
+	{
+		m_sign = value;
+		m_zero = value;
+	}
+
+	void 
+	cpu::stall(
+		__in uint32_t cycles
+		)
+	{
+		m_cycles += cycles;
+	}
+
+	void 
+	cpu::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_STARTED);
+		}
+
+#if TRACE >= TRACE_PROFILE
+		profile_clear();
+#endif // TRACE >= TRACE_PROFILE
+		reset();
+		m_started = true;
+	}
+
+	inline void 
+	cpu::step(
+		__in const mirra::instruction_t &entry
+		)
+	{
+		uint16_t operand;
+
+		switch(entry.length) {
+			case 1:
+				operand = read(m_program_counter++);
+				break;
+			case 2:
+				operand = read_word(m_program_counter);
+				m_program_counter += 2;
+				break;
+			default:
+				operand = 0;
+				break;
+		}
+
+		execute(entry, operand);
+	}
+
+	void 
+	cpu::step_block(
+		__in const mirra::decode_block_t &block
+		)
+	{
+		uint8_t iter;
+		uint32_t generation;
+
+		generation = m_mmu.generation();
+
+		for(iter = 0; iter < block.count; ++iter) {
+			const mirra::decode_t &instruction = block.instruction[iter];
+
+			m_program_counter += (instruction.entry->length + 1);
+			execute(*instruction.entry, instruction.operand);
+
+			if((m_cycles >= m_cycles_limit)
+					|| (generation != m_mmu.generation())) {
+				break;
+			}
+		}
+	}
+
+	void 
+	cpu::stop(void)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_CPU_EXCEPTION(MIRRA_CPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			clear();
+			m_started = false;
+		}
+	}
+
+	void 
+	cpu::store_high(
+		__in uint16_t address,
+		__in uint8_t index,
+		__in uint8_t value
+		)
+	{
+		uint16_t base = (address - index);
+
+		value &= (WORD_HIGH(base) + 1);
+
+		if(WORD_HIGH(base) != WORD_HIGH(address)) {
+			address = WORD(WORD_LOW(address), value);
+		}
+
+		write(address, value);
+	}
+
+	std::string 
+	cpu::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this)
+				<< ", ENG=" << ENGINE_STRING(m_engine);
+
+			if(m_started) {
+				result << ", EVT=" << CPU_EVENT_STRING(m_event)
+					<< ", CYCLES=" << m_cycles
+					<< ", A=" << mirra::cpu::register_as_string<uint8_t>(m_accumulator, verbose)
+					<< ", X=" << mirra::cpu::register_as_string<uint8_t>(m_index_x, verbose)
+					<< ", Y=" << mirra::cpu::register_as_string<uint8_t>(m_index_y, verbose)
+					<< ", FLG=" << mirra::cpu::register_as_string<uint8_t>(flag_pack(), verbose, true)
+					<< ", PC=" << mirra::cpu::register_as_string<uint16_t>(m_program_counter, verbose)
+					<< ", SP=" << mirra::cpu::register_as_string<uint16_t>(m_stack_pointer + STACK_BASE,
+						verbose);
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	cpu::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_breakpoint.clear();
+			dynarec_free();
+			m_mmu.detach();
+			m_decode.clear();
+			m_engine = ENGINE_TABLE;
+			m_ram = nullptr;
+			m_initialized = false;
+		}
+	}
+
+	mirra::status_t 
+	cpu::update(void)
+	{
+		mirra::status_t result = STATUS_SUCCESS;
+
+		if(UNLIKELY(!m_started)) {
+			result = STATUS_STATE(m_initialized);
+		} else if(UNLIKELY(interpret(1) == CPU_EVENT_HALT)) {
+			result = STATUS_HALTED;
+		}
+
+		return result;
+	}
+
+	inline void 
+	cpu::write(
+		__in uint16_t address,
+		__in uint8_t value
+		)
+	{
+		m_mmu.write(address, value);
+	}
+
+	template <mirra::address_t MODE> inline void 
+	cpu::write(
+		__in uint16_t address,
+		__in uint8_t value
+		)
+	{
+
+		if(ZERO_PAGE_MODE(MODE)) {
+			m_ram[address] = value;
+		} else {
+			write(address, value);
+		}
 	}
 
 	void 
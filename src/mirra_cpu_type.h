@@ -33,9 +33,13 @@ namespace mirra {
 #endif // NDEBUG
 
 	enum {
-		MIRRA_CPU_EXCEPTION_INITIALIZED = 0,
+		MIRRA_CPU_EXCEPTION_BREAKPOINT_NOT_FOUND = 0,
+		MIRRA_CPU_EXCEPTION_DYNAREC_ALLOCATION,
+		MIRRA_CPU_EXCEPTION_INITIALIZED,
+		MIRRA_CPU_EXCEPTION_INVALID_EVENT,
 		MIRRA_CPU_EXCEPTION_INVALID_INDIRECT,
-		MIRRA_CPU_EXCEPTION_INVALID_INSTRUCTION,
+		MIRRA_CPU_EXCEPTION_INVALID_PARAMETER,
+		MIRRA_CPU_EXCEPTION_PROFILE_EXPORT,
 		MIRRA_CPU_EXCEPTION_STARTED,
 		MIRRA_CPU_EXCEPTION_STOPPED,
 		MIRRA_CPU_EXCEPTION_UNINITIALIZED,
@@ -44,9 +48,13 @@ namespace mirra {
 	#define MIRRA_CPU_EXCEPTION_MAX MIRRA_CPU_EXCEPTION_UNINITIALIZED
 
 	static std::string MIRRA_CPU_EXCEPTION_STR[] = {
+		MIRRA_CPU_EXCEPTION_HEADER "Breakpoint does not exist",
+		MIRRA_CPU_EXCEPTION_HEADER "Failed to allocate dynarec buffer",
 		MIRRA_CPU_EXCEPTION_HEADER "CPU is initialized",
+		MIRRA_CPU_EXCEPTION_HEADER "Invalid event",
 		MIRRA_CPU_EXCEPTION_HEADER "Invalid indirect addressing mode",
-		MIRRA_CPU_EXCEPTION_HEADER "Invalid instruction",
+		MIRRA_CPU_EXCEPTION_HEADER "Invalid parameter type",
+		MIRRA_CPU_EXCEPTION_HEADER "Failed to export profile",
 		MIRRA_CPU_EXCEPTION_HEADER "CPU is started",
 		MIRRA_CPU_EXCEPTION_HEADER "CPU is stopped",
 		MIRRA_CPU_EXCEPTION_HEADER "CPU is uninitialized",
@@ -0,0 +1,628 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/mirra_database.h"
+#include "mirra_database_type.h"
+
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+#define DATABASE_CRC_NATIVE
+#endif // defined(__PCLMUL__) && defined(__SSE4_1__)
+
+#if defined(__SHA__) && defined(__SSE4_1__)
+#define DATABASE_SHA1_NATIVE
+#endif // defined(__SHA__) && defined(__SSE4_1__)
+
+#if defined(DATABASE_CRC_NATIVE) || defined(DATABASE_SHA1_NATIVE)
+#include <immintrin.h>
+#endif // defined(DATABASE_CRC_NATIVE) || defined(DATABASE_SHA1_NATIVE)
+
+namespace mirra {
+
+	static const std::string DATABASE_PARAMETER_STR[] = {
+		"PATH",
+		};
+
+	#define DATABASE_PARAMETER_STRING(_TYPE_) \
+		((_TYPE_) > DATABASE_PARAMETER_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(DATABASE_PARAMETER_STR[_TYPE_]))
+
+	#define DATABASE_CRC_POLYNOMIAL 0xedb88320
+	#define DATABASE_CRC_SEED UINT32_MAX
+	#define DATABASE_MAGIC 0x4244524d
+	#define DATABASE_SHA1_PAD 0x80
+	#define DATABASE_SHA1_PAD_LENGTH (DATABASE_BLOCK_SIZE - sizeof(uint64_t))
+
+	#define DATABASE_ROTATE(_VALUE_, _SHIFT_) \
+		(((_VALUE_) << (_SHIFT_)) | ((_VALUE_) >> (32 - (_SHIFT_))))
+
+#ifdef DATABASE_SHA1_NATIVE
+	#define DATABASE_SHA1_ROUND(_GROUP_) \
+		if((_GROUP_) < 4) { \
+			message[(_GROUP_) % 4] = _mm_shuffle_epi8(_mm_loadu_si128( \
+				(const __m128i *) (data + ((_GROUP_) * sizeof(__m128i)))), mask); \
+		} \
+		if(!(_GROUP_)) { \
+			next[0] = _mm_add_epi32(next[0], message[0]); \
+		} else { \
+			next[(_GROUP_) & 1] = _mm_sha1nexte_epu32(next[(_GROUP_) & 1], message[(_GROUP_) % 4]); \
+		} \
+		next[((_GROUP_) + 1) & 1] = abcd; \
+		message[((_GROUP_) + 1) % 4] = _mm_sha1msg2_epu32(message[((_GROUP_) + 1) % 4], message[(_GROUP_) % 4]); \
+		abcd = _mm_sha1rnds4_epu32(abcd, next[(_GROUP_) & 1], (_GROUP_) / 5); \
+		message[((_GROUP_) + 3) % 4] = _mm_sha1msg1_epu32(message[((_GROUP_) + 3) % 4], message[(_GROUP_) % 4]); \
+		message[((_GROUP_) + 2) % 4] = _mm_xor_si128(message[((_GROUP_) + 2) % 4], message[(_GROUP_) % 4]);
+#endif // DATABASE_SHA1_NATIVE
+
+	static const uint32_t DATABASE_SHA1_CONSTANT[] = {
+		0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6,
+		};
+
+	static const uint32_t DATABASE_SHA1_INITIAL[DATABASE_SHA1_STATE] = {
+		0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0,
+		};
+
+	database::database(void) :
+		mirra::singleton<mirra::database>(OBJECT_DATABASE),
+		m_base(nullptr),
+		m_count(0),
+		m_entry(nullptr),
+		m_initialized(false),
+		m_length(0),
+		m_started(false)
+	{
+		uint32_t bit, iter, slice, value;
+
+		for(iter = 0; iter <= UINT8_MAX; ++iter) {
+			value = iter;
+
+			for(bit = 0; bit < CHAR_BIT; ++bit) {
+				value = ((value & 1) ? ((value >> 1) ^ DATABASE_CRC_POLYNOMIAL) : (value >> 1));
+			}
+
+			m_crc[0][iter] = value;
+		}
+
+		for(slice = 1; slice < DATABASE_CRC_SLICE; ++slice) {
+
+			for(iter = 0; iter <= UINT8_MAX; ++iter) {
+				value = m_crc[slice - 1][iter];
+				m_crc[slice][iter] = ((value >> CHAR_BIT) ^ m_crc[0][value & UINT8_MAX]);
+			}
+		}
+	}
+
+	database::~database(void)
+	{
+		uninitialize();
+	}
+
+	uint32_t 
+	database::checksum(
+		__in const uint8_t *data,
+		__in size_t length
+		)
+	{
+		return ~crc(DATABASE_CRC_SEED, data, length);
+	}
+
+	bool 
+	database::compare(
+		__in const mirra::database_entry_t &left,
+		__in const mirra::database_entry_t &right
+		)
+	{
+
+		if(left.key.crc != right.key.crc) {
+			return (left.key.crc < right.key.crc);
+		}
+
+		return (std::memcmp(left.key.sha1, right.key.sha1, DATABASE_SHA1_LENGTH) < 0);
+	}
+
+	uint32_t 
+	database::crc(
+		__in uint32_t value,
+		__in const uint8_t *data,
+		__in size_t length
+		)
+	{
+		uint32_t high, low;
+#ifdef DATABASE_CRC_NATIVE
+		__m128i fold, mask, x1, x2, x3, x4, x5, x6, x7, x8;
+		static const uint64_t __attribute__((aligned(16))) K1K2[] = { 0x0154442bd4, 0x01c6e41596 };
+		static const uint64_t __attribute__((aligned(16))) K3K4[] = { 0x01751997d0, 0x00ccaa009e };
+		static const uint64_t __attribute__((aligned(16))) K5K0[] = { 0x0163cd6124, 0x0000000000 };
+		static const uint64_t __attribute__((aligned(16))) POLY[] = { 0x01db710641, 0x01f7011641 };
+
+		if(length >= DATABASE_BLOCK_SIZE) {
+			x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) data), _mm_cvtsi32_si128(value));
+			x2 = _mm_loadu_si128((const __m128i *) (data + 0x10));
+			x3 = _mm_loadu_si128((const __m128i *) (data + 0x20));
+			x4 = _mm_loadu_si128((const __m128i *) (data + 0x30));
+			fold = _mm_load_si128((const __m128i *) K1K2);
+			data += DATABASE_BLOCK_SIZE;
+			length -= DATABASE_BLOCK_SIZE;
+
+			for(; length >= DATABASE_BLOCK_SIZE; data += DATABASE_BLOCK_SIZE, length -= DATABASE_BLOCK_SIZE) {
+				x5 = _mm_clmulepi64_si128(x1, fold, 0x00);
+				x6 = _mm_clmulepi64_si128(x2, fold, 0x00);
+				x7 = _mm_clmulepi64_si128(x3, fold, 0x00);
+				x8 = _mm_clmulepi64_si128(x4, fold, 0x00);
+				x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, fold, 0x11), x5);
+				x2 = _mm_xor_si128(_mm_clmulepi64_si128(x2, fold, 0x11), x6);
+				x3 = _mm_xor_si128(_mm_clmulepi64_si128(x3, fold, 0x11), x7);
+				x4 = _mm_xor_si128(_mm_clmulepi64_si128(x4, fold, 0x11), x8);
+				x1 = _mm_xor_si128(x1, _mm_loadu_si128((const __m128i *) data));
+				x2 = _mm_xor_si128(x2, _mm_loadu_si128((const __m128i *) (data + 0x10)));
+				x3 = _mm_xor_si128(x3, _mm_loadu_si128((const __m128i *) (data + 0x20)));
+				x4 = _mm_xor_si128(x4, _mm_loadu_si128((const __m128i *) (data + 0x30)));
+			}
+
+			fold = _mm_load_si128((const __m128i *) K3K4);
+			x5 = _mm_clmulepi64_si128(x1, fold, 0x00);
+			x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, fold, 0x11), x2), x5);
+			x5 = _mm_clmulepi64_si128(x1, fold, 0x00);
+			x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, fold, 0x11), x3), x5);
+			x5 = _mm_clmulepi64_si128(x1, fold, 0x00);
+			x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, fold, 0x11), x4), x5);
+
+			for(; length >= sizeof(__m128i); data += sizeof(__m128i), length -= sizeof(__m128i)) {
+				x5 = _mm_clmulepi64_si128(x1, fold, 0x00);
+				x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, fold, 0x11),
+					_mm_loadu_si128((const __m128i *) data)), x5);
+			}
+
+			mask = _mm_setr_epi32(~0, 0, ~0, 0);
+			x2 = _mm_clmulepi64_si128(x1, fold, 0x10);
+			x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+			fold = _mm_loadl_epi64((const __m128i *) K5K0);
+			x2 = _mm_srli_si128(x1, 4);
+			x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), fold, 0x00), x2);
+			fold = _mm_load_si128((const __m128i *) POLY);
+			x2 = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), fold, 0x10), mask);
+			x1 = _mm_xor_si128(x1, _mm_clmulepi64_si128(x2, fold, 0x00));
+			value = _mm_extract_epi32(x1, 1);
+		}
+#endif // DATABASE_CRC_NATIVE
+
+		for(; length >= (2 * sizeof(uint32_t)); data += (2 * sizeof(uint32_t)), length -= (2 * sizeof(uint32_t))) {
+			std::memcpy(&low, data, sizeof(low));
+			std::memcpy(&high, data + sizeof(low), sizeof(high));
+			low ^= value;
+			value = (m_crc[7][low & UINT8_MAX] ^ m_crc[6][(low >> 8) & UINT8_MAX]
+				^ m_crc[5][(low >> 16) & UINT8_MAX] ^ m_crc[4][low >> 24]
+				^ m_crc[3][high & UINT8_MAX] ^ m_crc[2][(high >> 8) & UINT8_MAX]
+				^ m_crc[1][(high >> 16) & UINT8_MAX] ^ m_crc[0][high >> 24]);
+		}
+
+		for(; length; ++data, --length) {
+			value = (m_crc[0][(value ^ *data) & UINT8_MAX] ^ (value >> CHAR_BIT));
+		}
+
+		return value;
+	}
+
+	bool 
+	database::find(
+		__in const mirra::database_key_t &key,
+		__out mirra::database_entry_t &entry
+		)
+	{
+		mirra::database_entry_t probe = {};
+		const mirra::database_entry_t *result;
+
+		if(!m_entry) {
+			return false;
+		}
+
+		probe.key = key;
+
+		result = std::lower_bound(m_entry, m_entry + m_count, probe, mirra::database::compare);
+		if((result == (m_entry + m_count)) || (result->key.crc != key.crc)
+				|| std::memcmp(result->key.sha1, key.sha1, DATABASE_SHA1_LENGTH)) {
+			return false;
+		}
+
+		entry = *result;
+
+		return true;
+	}
+
+	void 
+	database::hash_begin(
+		__out mirra::database_hash_t &hash
+		)
+	{
+		hash.crc = DATABASE_CRC_SEED;
+		hash.length = 0;
+		std::memcpy(hash.state, DATABASE_SHA1_INITIAL, sizeof(hash.state));
+	}
+
+	void 
+	database::hash_end(
+		__in mirra::database_hash_t &hash,
+		__out mirra::database_key_t &key
+		)
+	{
+		uint32_t iter, offset = (hash.length % DATABASE_BLOCK_SIZE);
+
+		hash.block[offset++] = DATABASE_SHA1_PAD;
+
+		if(offset > DATABASE_SHA1_PAD_LENGTH) {
+			std::memset(&hash.block[offset], 0, DATABASE_BLOCK_SIZE - offset);
+			sha1(hash.state, hash.block, DATABASE_BLOCK_SIZE);
+			offset = 0;
+		}
+
+		std::memset(&hash.block[offset], 0, DATABASE_SHA1_PAD_LENGTH - offset);
+
+		for(iter = 0; iter < sizeof(uint64_t); ++iter) {
+			hash.block[DATABASE_BLOCK_SIZE - 1 - iter] = (((hash.length * CHAR_BIT) >> (iter * CHAR_BIT)) & UINT8_MAX);
+		}
+
+		sha1(hash.state, hash.block, DATABASE_BLOCK_SIZE);
+		key.crc = ~hash.crc;
+
+		for(iter = 0; iter < DATABASE_SHA1_LENGTH; ++iter) {
+			key.sha1[iter] = ((hash.state[iter / sizeof(uint32_t)] >> (24 - ((iter % sizeof(uint32_t)) * CHAR_BIT))) & UINT8_MAX);
+		}
+	}
+
+	void 
+	database::hash_update(
+		__in mirra::database_hash_t &hash,
+		__in const uint8_t *data,
+		__in size_t length
+		)
+	{
+		size_t count, offset = (hash.length % DATABASE_BLOCK_SIZE);
+
+		hash.crc = crc(hash.crc, data, length);
+		hash.length += length;
+
+		if(offset) {
+			count = std::min(length, (size_t) (DATABASE_BLOCK_SIZE - offset));
+			std::memcpy(&hash.block[offset], data, count);
+			data += count;
+			length -= count;
+
+			if((offset + count) < DATABASE_BLOCK_SIZE) {
+				return;
+			}
+
+			sha1(hash.state, hash.block, DATABASE_BLOCK_SIZE);
+		}
+
+		count = (length - (length % DATABASE_BLOCK_SIZE));
+		if(count) {
+			sha1(hash.state, data, count);
+			data += count;
+			length -= count;
+		}
+
+		if(length) {
+			std::memcpy(hash.block, data, length);
+		}
+	}
+
+	void 
+	database::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(m_initialized) {
+			THROW_MIRRA_DATABASE_EXCEPTION(MIRRA_DATABASE_EXCEPTION_INITIALIZED);
+		}
+
+		m_initialized = true;
+	}
+
+	bool 
+	database::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	database::is_loaded(void)
+	{
+		return (m_entry != nullptr);
+	}
+
+	bool 
+	database::is_started(void)
+	{
+		return m_started;
+	}
+
+	void 
+	database::load(
+		__in const std::string &path
+		)
+	{
+		int handle;
+		void *result;
+		uint32_t iter;
+		struct stat status;
+		mirra::database_header_t header = {};
+
+		handle = open(path.c_str(), O_RDONLY);
+		if(handle < 0) {
+			THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_EXTERNAL,
+				"%s: %s", path.c_str(), std::strerror(errno));
+		}
+
+		if(fstat(handle, &status) || (read(handle, &header, sizeof(header)) != sizeof(header))
+				|| (header.magic != DATABASE_MAGIC) || (header.version != DATABASE_VERSION)
+				|| (header.size != sizeof(mirra::database_entry_t))
+				|| ((size_t) status.st_size != (sizeof(header) + (header.count * (size_t) header.size)))) {
+			close(handle);
+			THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_INVALID_FORMAT,
+				"%s", path.c_str());
+		}
+
+		result = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, handle, 0);
+		close(handle);
+
+		if(result == MAP_FAILED) {
+			THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_EXTERNAL,
+				"%s: %s", path.c_str(), std::strerror(errno));
+		}
+
+		madvise(result, status.st_size, MADV_RANDOM);
+		m_base = (uint8_t *) result;
+		m_length = status.st_size;
+		m_count = header.count;
+		m_entry = (const mirra::database_entry_t *) (m_base + sizeof(header));
+		m_path = path;
+
+		for(iter = 1; iter < m_count; ++iter) {
+
+			if(!compare(m_entry[iter - 1], m_entry[iter])) {
+				unload();
+				THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_INVALID_FORMAT,
+					"%s: entry %u out of order", path.c_str(), iter);
+			}
+		}
+	}
+
+	void 
+	database::sha1(
+		__inout uint32_t *state,
+		__in const uint8_t *data,
+		__in size_t length
+		)
+	{
+#ifdef DATABASE_SHA1_NATIVE
+		__m128i abcd, abcd_save, next[2], next_save, message[4] = {};
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+		abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) state), 0x1b);
+		next[0] = _mm_set_epi32(state[4], 0, 0, 0);
+		next[1] = next[0];
+
+		for(; length >= DATABASE_BLOCK_SIZE; data += DATABASE_BLOCK_SIZE, length -= DATABASE_BLOCK_SIZE) {
+			abcd_save = abcd;
+			next_save = next[0];
+			DATABASE_SHA1_ROUND(0) DATABASE_SHA1_ROUND(1) DATABASE_SHA1_ROUND(2) DATABASE_SHA1_ROUND(3)
+			DATABASE_SHA1_ROUND(4) DATABASE_SHA1_ROUND(5) DATABASE_SHA1_ROUND(6) DATABASE_SHA1_ROUND(7)
+			DATABASE_SHA1_ROUND(8) DATABASE_SHA1_ROUND(9) DATABASE_SHA1_ROUND(10) DATABASE_SHA1_ROUND(11)
+			DATABASE_SHA1_ROUND(12) DATABASE_SHA1_ROUND(13) DATABASE_SHA1_ROUND(14) DATABASE_SHA1_ROUND(15)
+			DATABASE_SHA1_ROUND(16) DATABASE_SHA1_ROUND(17) DATABASE_SHA1_ROUND(18) DATABASE_SHA1_ROUND(19)
+			next[0] = _mm_sha1nexte_epu32(next[0], next_save);
+			abcd = _mm_add_epi32(abcd, abcd_save);
+		}
+
+		_mm_storeu_si128((__m128i *) state, _mm_shuffle_epi32(abcd, 0x1b));
+		state[4] = _mm_extract_epi32(next[0], 3);
+#else
+		uint32_t a, b, c, d, e, iter, value, word[80];
+
+		for(; length >= DATABASE_BLOCK_SIZE; data += DATABASE_BLOCK_SIZE, length -= DATABASE_BLOCK_SIZE) {
+
+			for(iter = 0; iter < 16; ++iter) {
+				word[iter] = ((data[iter * 4] << 24) | (data[(iter * 4) + 1] << 16)
+					| (data[(iter * 4) + 2] << 8) | data[(iter * 4) + 3]);
+			}
+
+			for(; iter < 80; ++iter) {
+				value = (word[iter - 3] ^ word[iter - 8] ^ word[iter - 14] ^ word[iter - 16]);
+				word[iter] = DATABASE_ROTATE(value, 1);
+			}
+
+			a = state[0];
+			b = state[1];
+			c = state[2];
+			d = state[3];
+			e = state[4];
+
+			for(iter = 0; iter < 80; ++iter) {
+
+				if(iter < 20) {
+					value = ((b & c) | (~b & d));
+				} else if((iter >= 40) && (iter < 60)) {
+					value = ((b & c) | (b & d) | (c & d));
+				} else {
+					value = (b ^ c ^ d);
+				}
+
+				value += (DATABASE_ROTATE(a, 5) + e + DATABASE_SHA1_CONSTANT[iter / 20] + word[iter]);
+				e = d;
+				d = c;
+				c = DATABASE_ROTATE(b, 30);
+				b = a;
+				a = value;
+			}
+
+			state[0] += a;
+			state[1] += b;
+			state[2] += c;
+			state[3] += d;
+			state[4] += e;
+		}
+#endif // DATABASE_SHA1_NATIVE
+	}
+
+	void 
+	database::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+		std::string path;
+		mirra::parameter_t::const_iterator iter;
+		mirra::object_parameter_t::const_iterator attribute_iter;
+
+		if(!m_initialized) {
+			THROW_MIRRA_DATABASE_EXCEPTION(MIRRA_DATABASE_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_DATABASE_EXCEPTION(MIRRA_DATABASE_EXCEPTION_STARTED);
+		}
+
+		iter = parameter.find(OBJECT_DATABASE);
+		if(iter != parameter.end()) {
+
+			attribute_iter = iter->second.find(DATABASE_PARAMETER_PATH);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_STRING)
+						|| !attribute_iter->second.data.strvalue) {
+					THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s)", DATABASE_PARAMETER_STRING(DATABASE_PARAMETER_PATH),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_STRING));
+				}
+
+				path = attribute_iter->second.data.strvalue;
+			}
+		}
+
+		if(!path.empty()) {
+			load(path);
+		}
+
+		m_started = true;
+	}
+
+	void 
+	database::stop(void)
+	{
+
+		if(m_initialized && m_started) {
+			m_started = false;
+			unload();
+		}
+	}
+
+	std::string 
+	database::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this);
+
+			if(m_started && is_loaded()) {
+				result << ", PATH=" << m_path
+					<< ", BASE=" << SCALAR_AS_HEX(uintptr_t, m_base) << " (" << m_count << " entries)";
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	database::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_initialized = false;
+		}
+	}
+
+	void 
+	database::unload(void)
+	{
+
+		if(m_base) {
+			munmap(m_base, m_length);
+			m_base = nullptr;
+		}
+
+		m_count = 0;
+		m_entry = nullptr;
+		m_length = 0;
+		m_path.clear();
+	}
+
+	void 
+	database::write(
+		__in const std::string &path,
+		__in std::vector<mirra::database_entry_t> entry
+		)
+	{
+		std::ofstream file;
+		mirra::database_header_t header = {};
+
+		std::sort(entry.begin(), entry.end(), mirra::database::compare);
+		entry.erase(std::unique(entry.begin(), entry.end(),
+			[](const mirra::database_entry_t &left, const mirra::database_entry_t &right) {
+				return !compare(left, right) && !compare(right, left);
+			}), entry.end());
+		header.magic = DATABASE_MAGIC;
+		header.version = DATABASE_VERSION;
+		header.size = sizeof(mirra::database_entry_t);
+		header.count = entry.size();
+
+		file.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if(!file) {
+			THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_EXTERNAL,
+				"%s", path.c_str());
+		}
+
+		file.write((const char *) &header, sizeof(header));
+
+		if(!entry.empty()) {
+			file.write((const char *) &entry[0], entry.size() * sizeof(mirra::database_entry_t));
+		}
+
+		if(!file) {
+			THROW_MIRRA_DATABASE_EXCEPTION_FORMAT(MIRRA_DATABASE_EXCEPTION_EXTERNAL,
+				"%s", path.c_str());
+		}
+	}
+}
@@ -17,6 +17,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include "../include/mirra_display.h"
 #include "mirra_display_type.h"
 
@@ -30,10 +31,6 @@ namespace mirra {
 	#define WINDOW_RENDERER_INIT_FLAGS (SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC \
 		| SDL_RENDERER_TARGETTEXTURE)
 
-	#define PIXEL_FILL RGB(0, 0, 0)
-
-	#define PIXEL_INDEX(_X_, _Y_, _W_) (((_Y_) * (_W_)) + (_X_))
-
 	static const std::string DISPLAY_PARAMETER_STR[] = {
 		"HEIGHT", "TITLE", "WIDTH",
 		};
@@ -48,6 +45,9 @@ namespace mirra {
 		m_renderer_height(0),
 		m_renderer_width(0),
 		m_started(false),
+		m_status(STATUS_SUCCESS),
+		m_texture_height(0),
+		m_texture_width(0),
 		m_window(nullptr),
 		m_window_renderer(nullptr),
 		m_window_texture(nullptr)
@@ -60,31 +60,6 @@ namespace mirra {
 		uninitialize();
 	}
 
-	uint32_t 
-	display::at(
-		__in uint32_t x,
-		__in uint32_t y
-		)
-	{
-		uint32_t index;
-
-		if(!m_initialized) {
-			THROW_MIRRA_DISPLAY_EXCEPTION(MIRRA_DISPLAY_EXCEPTION_UNINITIALIZED);
-		}
-
-		if(!m_started) {
-			THROW_MIRRA_DISPLAY_EXCEPTION(MIRRA_DISPLAY_EXCEPTION_STOPPED);
-		}
-
-		index = PIXEL_INDEX(x, y, m_renderer_width);
-		if(index >= m_frame.size()) {
-			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_INVALID_COORDINATE,
-				"{%u, %u} [%u]", x, y, index);
-		}
-
-		return m_frame.at(index);
-	}
-
 	void 
 	display::clear(void)
 	{
@@ -128,13 +103,16 @@ namespace mirra {
 	}
 
 	void 
-	display::set(
-		__in uint32_t x,
-		__in uint32_t y,
-		__in uint32_t color
+	display::present(
+		__in const uint8_t *frame,
+		__in uint32_t width,
+		__in uint32_t height,
+		__in const uint32_t *palette
 		)
 	{
-		uint32_t index;
+		int pitch;
+		void *pixels;
+		uint32_t *row, x, y;
 
 		if(!m_initialized) {
 			THROW_MIRRA_DISPLAY_EXCEPTION(MIRRA_DISPLAY_EXCEPTION_UNINITIALIZED);
@@ -144,13 +122,38 @@ namespace mirra {
 			THROW_MIRRA_DISPLAY_EXCEPTION(MIRRA_DISPLAY_EXCEPTION_STOPPED);
 		}
 
-		index = PIXEL_INDEX(x, y, m_renderer_width);
-		if(index >= m_frame.size()) {
-			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_INVALID_COORDINATE,
-				"{%u, %u} [%u]", x, y, index);
+		if(SDL_LockTexture(m_window_texture, nullptr, &pixels, &pitch)) {
+			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_EXTERNAL,
+				"SDL_LockTexture: %s", SDL_GetError());
+		}
+
+		for(y = 0; y < std::min(height, m_texture_height); ++y) {
+			row = (uint32_t *) ((uint8_t *) pixels + (y * pitch));
+
+			for(x = 0; x < std::min(width, m_texture_width); ++x) {
+				row[x] = palette[frame[PIXEL_INDEX(x, y, width)]];
+			}
+		}
+
+		SDL_UnlockTexture(m_window_texture);
+		render();
+	}
+
+	void 
+	display::render(void)
+	{
+
+		if(SDL_RenderClear(m_window_renderer)) {
+			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_EXTERNAL,
+				"SDL_RenderClear: %s", SDL_GetError());
+		}
+
+		if(SDL_RenderCopy(m_window_renderer, m_window_texture, nullptr, nullptr)) {
+			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_EXTERNAL,
+				"SDL_RenderCopy: %s", SDL_GetError());
 		}
 
-		m_frame.at(index) = color;
+		SDL_RenderPresent(m_window_renderer);
 	}
 
 	void 
@@ -253,10 +256,23 @@ namespace mirra {
 				"SDL_SetTextureBlendMode: %s", SDL_GetError());
 		}
 
+		m_texture_height = height;
+		m_texture_width = width;
 		m_started = true;
+		m_status = STATUS_SUCCESS;
 		clear();
 	}
 
+	mirra::status_t 
+	display::status(void)
+	{
+		mirra::status_t result = m_status;
+
+		m_status = STATUS_SUCCESS;
+
+		return result;
+	}
+
 	void 
 	display::stop(void)
 	{
@@ -281,6 +297,8 @@ namespace mirra {
 
 			m_renderer_height = 0;
 			m_renderer_width = 0;
+			m_texture_height = 0;
+			m_texture_width = 0;
 			m_frame.clear();
 		}
 	}
@@ -337,16 +355,6 @@ namespace mirra {
 				"SDL_UpdateTexture: %s", SDL_GetError());
 		}
 
-		if(SDL_RenderClear(m_window_renderer)) {
-			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_RenderClear: %s", SDL_GetError());
-		}
-
-		if(SDL_RenderCopy(m_window_renderer, m_window_texture, nullptr, nullptr)) {
-			THROW_MIRRA_DISPLAY_EXCEPTION_FORMAT(MIRRA_DISPLAY_EXCEPTION_EXTERNAL,
-				"SDL_RenderCopy: %s", SDL_GetError());
-		}
-
-		SDL_RenderPresent(m_window_renderer);
+		render();
 	}
 }
@@ -35,7 +35,6 @@ namespace mirra {
 	enum {
 		MIRRA_DISPLAY_EXCEPTION_EXTERNAL = 0,
 		MIRRA_DISPLAY_EXCEPTION_INITIALIZED,
-		MIRRA_DISPLAY_EXCEPTION_INVALID_COORDINATE,
 		MIRRA_DISPLAY_EXCEPTION_INVALID_PARAMETER,
 		MIRAR_DISPLAY_EXCEPTION_STARTED,
 		MIRRA_DISPLAY_EXCEPTION_STOPPED,
@@ -47,7 +46,6 @@ namespace mirra {
 	static const std::string MIRRA_DISPLAY_EXCEPTION_STR[] = {
 		MIRRA_DISPLAY_EXCEPTION_HEADER "External exception",
 		MIRRA_DISPLAY_EXCEPTION_HEADER "Display is initialized",
-		MIRRA_DISPLAY_EXCEPTION_HEADER "Invalid pixel coordinate",
 		MIRRA_DISPLAY_EXCEPTION_HEADER "Invalid parameter type",
 		MIRRA_DISPLAY_EXCEPTION_HEADER "Display is started",
 		MIRRA_DISPLAY_EXCEPTION_HEADER "Display is stopped",
@@ -63,7 +63,8 @@ namespace mirra {
 	input::input(void) :
 		mirra::singleton<mirra::input>(OBJECT_INPUT),
 		m_initialized(false),
-		m_started(false)
+		m_started(false),
+		m_status(STATUS_SUCCESS)
 	{
 		return;
 	}
@@ -138,6 +139,28 @@ namespace mirra {
 		return iter->second;
 	}
 
+	std::map<SDL_Scancode, bool>::iterator 
+	input::find_state(
+		__in mirra::joypad_t joypad,
+		__in mirra::button_t button
+		)
+	{
+		std::map<mirra::button_t, SDL_Scancode>::iterator button_iter;
+		std::map<SDL_Scancode, bool>::iterator result = m_button_state.end();
+		std::map<mirra::joypad_t, std::map<mirra::button_t, SDL_Scancode>>::iterator joypad_iter;
+
+		joypad_iter = m_button.find(joypad);
+		if(LIKELY(joypad_iter != m_button.end())) {
+
+			button_iter = joypad_iter->second.find(button);
+			if(LIKELY(button_iter != joypad_iter->second.end())) {
+				result = m_button_state.find(button_iter->second);
+			}
+		}
+
+		return result;
+	}
+
 	void 
 	input::initialize(
 		__in_opt const mirra::parameter_t &parameter
@@ -163,15 +186,22 @@ namespace mirra {
 		__in mirra::button_t button
 		)
 	{
-		if(!m_initialized) {
-			THROW_MIRRA_INPUT_EXCEPTION(MIRRA_INPUT_EXCEPTION_UNINITIALIZED);
-		}
+		bool result = false;
+		std::map<SDL_Scancode, bool>::iterator iter;
 
-		if(!m_started) {
-			THROW_MIRRA_INPUT_EXCEPTION(MIRRA_INPUT_EXCEPTION_STOPPED);
+		if(UNLIKELY(!m_started)) {
+			m_status = STATUS_STATE(m_initialized);
+		} else {
+
+			iter = find_state(joypad, button);
+			if(LIKELY(iter != m_button_state.end())) {
+				result = iter->second;
+			} else {
+				m_status = STATUS_NOT_FOUND;
+			}
 		}
 
-		return find_button_state(joypad, button);
+		return result;
 	}
 
 	bool 
@@ -188,28 +218,25 @@ namespace mirra {
 		return find_button_state(joypad, find_button_position(joypad));
 	}
 
-	void 
+	mirra::status_t 
 	input::process(
 		__in const SDL_KeyboardEvent &event
 		)
 	{
+		mirra::status_t result = STATUS_SUCCESS;
 		std::map<SDL_Scancode, bool>::iterator iter;
 
-		if(!m_initialized) {
-			THROW_MIRRA_INPUT_EXCEPTION(MIRRA_INPUT_EXCEPTION_UNINITIALIZED);
-		}
-
-		if(!m_started) {
-			THROW_MIRRA_INPUT_EXCEPTION(MIRRA_INPUT_EXCEPTION_STOPPED);
-		}
-
-		if(!event.repeat) {
+		if(UNLIKELY(!m_started)) {
+			result = STATUS_STATE(m_initialized);
+		} else if(!event.repeat) {
 
 			iter = m_button_state.find(event.keysym.scancode);
 			if(iter != m_button_state.end()) {
 				iter->second = (event.state == SDL_PRESSED);
 			}
 		}
+
+		return result;
 	}
 
 	void 
@@ -331,6 +358,17 @@ namespace mirra {
 		}
 
 		m_started = true;
+		m_status = STATUS_SUCCESS;
+	}
+
+	mirra::status_t 
+	input::status(void)
+	{
+		mirra::status_t result = m_status;
+
+		m_status = STATUS_SUCCESS;
+
+		return result;
 	}
 
 	void 
@@ -0,0 +1,530 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include "../include/mirra_mapper.h"
+#include "mirra_mapper_type.h"
+
+namespace mirra {
+
+	#define MAPPER_ENTRY(_TYPE_, _NUMBER_) \
+		{ _NUMBER_, &mirra::mapper::reset<MAPPER_TYPE_ ## _TYPE_>, \
+			&mirra::mapper::write_register<MAPPER_TYPE_ ## _TYPE_>, #_TYPE_ }
+
+	#define MAPPER_FOUR_SCREEN(_MIRRORING_) ((_MIRRORING_) == ROM_MIRRORING_FOUR_SCREEN)
+
+	#define MAPPER_MMC1_CONTROL 0
+	#define MAPPER_MMC1_CONTROL_CHR 0x10
+	#define MAPPER_MMC1_CONTROL_PRG 0x0c
+	#define MAPPER_MMC1_CHR_0 1
+	#define MAPPER_MMC1_CHR_1 2
+	#define MAPPER_MMC1_PRG 3
+	#define MAPPER_MMC1_RESET 0x80
+	#define MAPPER_MMC1_SHIFT 0x10
+
+	#define MAPPER_MMC3_CHR_INVERT 0x80
+	#define MAPPER_MMC3_IRQ_DISABLE 0xe000
+	#define MAPPER_MMC3_IRQ_ENABLE 0xe001
+	#define MAPPER_MMC3_IRQ_LATCH 0xc000
+	#define MAPPER_MMC3_IRQ_RELOAD 0xc001
+	#define MAPPER_MMC3_PRG_SWAP 0x40
+	#define MAPPER_MMC3_REGISTER_MASK 0xe001
+	#define MAPPER_MMC3_SELECT_MASK 0x07
+
+	static const mirra::rom_mirroring_t MAPPER_MMC1_MIRRORING[] = {
+		ROM_MIRRORING_SINGLE_LOWER, ROM_MIRRORING_SINGLE_UPPER,
+		ROM_MIRRORING_VERTICAL, ROM_MIRRORING_HORIZONTAL,
+		};
+
+	static const uint8_t MAPPER_MMC3_REGISTER[MAPPER_REGISTER_COUNT] = {
+		0, 2, 4, 5, 6, 7, 0, 1,
+		};
+
+	const mirra::mapper_entry_t mapper::MAPPER_TABLE[MAPPER_TYPE_MAX + 1] = {
+		MAPPER_ENTRY(NROM, 0),
+		MAPPER_ENTRY(MMC1, 1),
+		MAPPER_ENTRY(UXROM, 2),
+		MAPPER_ENTRY(CNROM, 3),
+		MAPPER_ENTRY(MMC3, 4),
+		MAPPER_ENTRY(AXROM, 7),
+		};
+
+	mapper::mapper(void) :
+		mirra::singleton<mirra::mapper>(OBJECT_MAPPER),
+		m_cpu(mirra::cpu::acquire()),
+		m_initialized(false),
+		m_mmu(mirra::mmu::acquire()),
+		m_rom(mirra::rom::acquire()),
+		m_scheduler(mirra::scheduler::acquire()),
+		m_started(false)
+	{
+		clear();
+	}
+
+	mapper::~mapper(void)
+	{
+		uninitialize();
+	}
+
+	void 
+	mapper::bank_chr(
+		__in uint32_t slot,
+		__in uint32_t count,
+		__in uint32_t bank
+		)
+	{
+		uint32_t iter, banks = (m_chr_size >> MAPPER_CHR_BANK_WIDTH);
+
+		for(iter = 0; iter < count; ++iter) {
+			m_chr[slot + iter] = (m_chr_base + ((((bank * count) + iter) % banks) << MAPPER_CHR_BANK_WIDTH));
+		}
+	}
+
+	void 
+	mapper::bank_prg(
+		__in uint32_t slot,
+		__in uint32_t count,
+		__in uint32_t bank
+		)
+	{
+		const uint8_t *source;
+		uint32_t index, iter, banks = (m_prg_size >> MAPPER_PRG_BANK_WIDTH);
+
+		for(iter = 0; iter < count; ++iter) {
+			index = (((bank * count) + iter) % banks);
+			source = (m_rom.prg() + (index << MAPPER_PRG_BANK_WIDTH));
+
+			if(m_prg[slot + iter] != source) {
+				m_prg[slot + iter] = source;
+				m_mmu.map(MAPPER_PRG_ADDRESS + ((slot + iter) << MAPPER_PRG_BANK_WIDTH), MAPPER_PRG_BANK_SIZE,
+					(uint8_t *) source, nullptr, this, index);
+			}
+		}
+	}
+
+	void 
+	mapper::clear(void)
+	{
+		uint32_t iter;
+
+		m_chr_base = (m_chr_ram.empty() ? nullptr : &m_chr_ram[0]);
+		m_chr_size = m_chr_ram.size();
+		m_chr_writable = !m_chr_ram.empty();
+
+		for(iter = 0; iter < MAPPER_CHR_BANK_COUNT; ++iter) {
+			m_chr[iter] = (m_chr_base ? (m_chr_base + (iter << MAPPER_CHR_BANK_WIDTH)) : nullptr);
+		}
+
+		for(iter = 0; iter < MAPPER_PRG_BANK_COUNT; ++iter) {
+			m_prg[iter] = nullptr;
+		}
+
+		for(iter = 0; iter < MAPPER_REGISTER_COUNT; ++iter) {
+			m_register[iter] = 0;
+		}
+
+		m_entry = nullptr;
+		m_irq_counter = 0;
+		m_irq_enable = false;
+		m_irq_latch = 0;
+		m_irq_reload = false;
+		m_mirroring = ROM_MIRRORING_HORIZONTAL;
+		m_prg_size = 0;
+		m_select = 0;
+		m_shift = MAPPER_MMC1_SHIFT;
+	}
+
+	void 
+	mapper::clock(void)
+	{
+
+		if(!m_irq_counter || m_irq_reload) {
+			m_irq_counter = m_irq_latch;
+			m_irq_reload = false;
+		} else {
+			--m_irq_counter;
+		}
+
+		if(!m_irq_counter && m_irq_enable) {
+			m_cpu.interrupt_assert(INTERRUPT_LINE_MAPPER);
+		}
+	}
+
+	void 
+	mapper::edge(
+		__in uint64_t cycle
+		)
+	{
+
+		if(type() == MAPPER_TYPE_MMC3) {
+			m_scheduler.schedule(SCHEDULER_EVENT_MAPPER, cycle);
+		}
+	}
+
+	void 
+	mapper::fire(
+		__in mirra::scheduler_event_t event,
+		__in uint64_t cycle
+		)
+	{
+		clock();
+	}
+
+	void 
+	mapper::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(m_initialized) {
+			THROW_MIRRA_MAPPER_EXCEPTION(MIRRA_MAPPER_EXCEPTION_INITIALIZED);
+		}
+
+		m_chr_ram.resize(MAPPER_CHR_RAM_SIZE, 0);
+		clear();
+		m_initialized = true;
+	}
+
+	bool 
+	mapper::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	mapper::is_started(void)
+	{
+		return m_started;
+	}
+
+	template <mirra::mapper_type_t TYPE> void 
+	mapper::reset(void)
+	{
+		uint32_t iter;
+
+		switch(TYPE) {
+			case MAPPER_TYPE_AXROM:
+				bank_prg(0, MAPPER_PRG_BANK_COUNT, 0);
+				bank_chr(0, MAPPER_CHR_BANK_COUNT, 0);
+				m_mirroring = ROM_MIRRORING_SINGLE_LOWER;
+				break;
+			case MAPPER_TYPE_MMC1:
+				m_register[MAPPER_MMC1_CONTROL] = MAPPER_MMC1_CONTROL_PRG;
+				m_shift = MAPPER_MMC1_SHIFT;
+				select<TYPE>();
+				break;
+			case MAPPER_TYPE_MMC3:
+
+				for(iter = 0; iter < MAPPER_REGISTER_COUNT; ++iter) {
+					m_register[iter] = MAPPER_MMC3_REGISTER[iter];
+				}
+
+				m_select = 0;
+				select<TYPE>();
+				m_scheduler.attach(SCHEDULER_EVENT_MAPPER, this);
+				break;
+			case MAPPER_TYPE_UXROM:
+				bank_prg(0, 2, 0);
+				bank_prg(2, 2, (m_prg_size / ROM_BANK_PRG_SIZE) - 1);
+				bank_chr(0, MAPPER_CHR_BANK_COUNT, 0);
+				break;
+			default:
+				bank_prg(0, MAPPER_PRG_BANK_COUNT, 0);
+				bank_chr(0, MAPPER_CHR_BANK_COUNT, 0);
+				break;
+		}
+	}
+
+	template <mirra::mapper_type_t TYPE> void 
+	mapper::select(void)
+	{
+		uint8_t control, prg;
+		uint32_t last = ((m_prg_size >> MAPPER_PRG_BANK_WIDTH) - 1);
+
+		switch(TYPE) {
+			case MAPPER_TYPE_MMC1:
+				control = m_register[MAPPER_MMC1_CONTROL];
+				prg = (m_register[MAPPER_MMC1_PRG] & 0x0f);
+
+				if(!MAPPER_FOUR_SCREEN(m_mirroring)) {
+					m_mirroring = MAPPER_MMC1_MIRRORING[control & 3];
+				}
+
+				if(control & MAPPER_MMC1_CONTROL_CHR) {
+					bank_chr(0, 4, m_register[MAPPER_MMC1_CHR_0]);
+					bank_chr(4, 4, m_register[MAPPER_MMC1_CHR_1]);
+				} else {
+					bank_chr(0, MAPPER_CHR_BANK_COUNT, m_register[MAPPER_MMC1_CHR_0] >> 1);
+				}
+
+				switch((control & MAPPER_MMC1_CONTROL_PRG) >> 2) {
+					case 2:
+						bank_prg(0, 2, 0);
+						bank_prg(2, 2, prg);
+						break;
+					case 3:
+						bank_prg(0, 2, prg);
+						bank_prg(2, 2, last >> 1);
+						break;
+					default:
+						bank_prg(0, MAPPER_PRG_BANK_COUNT, prg >> 1);
+						break;
+				}
+				break;
+			case MAPPER_TYPE_MMC3:
+
+				if(m_select & MAPPER_MMC3_CHR_INVERT) {
+					bank_chr(0, 1, m_register[2]);
+					bank_chr(1, 1, m_register[3]);
+					bank_chr(2, 1, m_register[4]);
+					bank_chr(3, 1, m_register[5]);
+					bank_chr(4, 2, m_register[0] >> 1);
+					bank_chr(6, 2, m_register[1] >> 1);
+				} else {
+					bank_chr(0, 2, m_register[0] >> 1);
+					bank_chr(2, 2, m_register[1] >> 1);
+					bank_chr(4, 1, m_register[2]);
+					bank_chr(5, 1, m_register[3]);
+					bank_chr(6, 1, m_register[4]);
+					bank_chr(7, 1, m_register[5]);
+				}
+
+				if(m_select & MAPPER_MMC3_PRG_SWAP) {
+					bank_prg(0, 1, last - 1);
+					bank_prg(2, 1, m_register[6] & 0x3f);
+				} else {
+					bank_prg(0, 1, m_register[6] & 0x3f);
+					bank_prg(2, 1, last - 1);
+				}
+
+				bank_prg(1, 1, m_register[7] & 0x3f);
+				bank_prg(3, 1, last);
+				break;
+			default:
+				break;
+		}
+	}
+
+	void 
+	mapper::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+		uint32_t iter;
+
+		if(!m_initialized) {
+			THROW_MIRRA_MAPPER_EXCEPTION(MIRRA_MAPPER_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_MAPPER_EXCEPTION(MIRRA_MAPPER_EXCEPTION_STARTED);
+		}
+
+		clear();
+		std::fill(m_chr_ram.begin(), m_chr_ram.end(), 0);
+
+		if(m_rom.is_loaded()) {
+
+			for(iter = 0; iter <= MAPPER_TYPE_MAX; ++iter) {
+
+				if(MAPPER_TABLE[iter].number == m_rom.mapper()) {
+					break;
+				}
+			}
+
+			if(iter > MAPPER_TYPE_MAX) {
+				THROW_MIRRA_MAPPER_EXCEPTION_FORMAT(MIRRA_MAPPER_EXCEPTION_UNSUPPORTED,
+					"%u", m_rom.mapper());
+			}
+
+			if(m_rom.chr_size()) {
+				m_chr_base = (uint8_t *) m_rom.chr();
+				m_chr_size = m_rom.chr_size();
+				m_chr_writable = false;
+			}
+
+			m_entry = &MAPPER_TABLE[iter];
+			m_mirroring = m_rom.mirroring();
+			m_prg_size = m_rom.prg_size();
+			(this->*m_entry->reset)();
+		}
+
+		m_started = true;
+	}
+
+	void 
+	mapper::stop(void)
+	{
+
+		if(m_initialized && m_started) {
+			m_started = false;
+
+			if(m_entry && m_mmu.is_started()) {
+				m_mmu.unmap(MAPPER_PRG_ADDRESS, MAPPER_PRG_BANK_COUNT * MAPPER_PRG_BANK_SIZE);
+			}
+
+			if(type() == MAPPER_TYPE_MMC3) {
+				m_scheduler.cancel(SCHEDULER_EVENT_MAPPER);
+				m_scheduler.detach(SCHEDULER_EVENT_MAPPER);
+				m_cpu.interrupt_release(INTERRUPT_LINE_MAPPER);
+			}
+
+			clear();
+		}
+	}
+
+	std::string 
+	mapper::to_string(
+		__in_opt bool verbose
+		)
+	{
+		uint32_t iter;
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this);
+
+			if(m_started && m_entry) {
+				result << ", TYPE=" << m_entry->name << " (" << m_entry->number << ")"
+					<< ", PRG={";
+
+				for(iter = 0; iter < MAPPER_PRG_BANK_COUNT; ++iter) {
+					result << (iter ? ", " : "")
+						<< m_mmu.bank(MAPPER_PRG_ADDRESS + (iter << MAPPER_PRG_BANK_WIDTH));
+				}
+
+				result << "}, CHR={";
+
+				for(iter = 0; iter < MAPPER_CHR_BANK_COUNT; ++iter) {
+					result << (iter ? ", " : "")
+						<< ((m_chr[iter] - m_chr_base) >> MAPPER_CHR_BANK_WIDTH);
+				}
+
+				result << "}" << (m_chr_writable ? ", CHR-RAM" : "");
+
+				if(type() == MAPPER_TYPE_MMC3) {
+					result << ", IRQ=" << (uint32_t) m_irq_counter << "/" << (uint32_t) m_irq_latch
+						<< (m_irq_enable ? " (EN)" : "");
+				}
+			}
+		}
+
+		return result.str();
+	}
+
+	mirra::mapper_type_t 
+	mapper::type(void)
+	{
+		return (m_entry ? (mirra::mapper_type_t) (m_entry - MAPPER_TABLE) : MAPPER_TYPE_NROM);
+	}
+
+	void 
+	mapper::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_chr_ram.clear();
+			m_chr_ram.shrink_to_fit();
+			clear();
+			m_initialized = false;
+		}
+	}
+
+	template <mirra::mapper_type_t TYPE> void 
+	mapper::write_register(
+		__in uint16_t address,
+		__in uint8_t value
+		)
+	{
+		bool complete;
+
+		switch(TYPE) {
+			case MAPPER_TYPE_AXROM:
+				bank_prg(0, MAPPER_PRG_BANK_COUNT, value & 0x07);
+				m_mirroring = ((value & 0x10) ? ROM_MIRRORING_SINGLE_UPPER : ROM_MIRRORING_SINGLE_LOWER);
+				break;
+			case MAPPER_TYPE_CNROM:
+				bank_chr(0, MAPPER_CHR_BANK_COUNT, value);
+				break;
+			case MAPPER_TYPE_MMC1:
+
+				if(value & MAPPER_MMC1_RESET) {
+					m_register[MAPPER_MMC1_CONTROL] |= MAPPER_MMC1_CONTROL_PRG;
+					m_shift = MAPPER_MMC1_SHIFT;
+					select<TYPE>();
+				} else {
+					complete = (m_shift & 1);
+					m_shift = ((m_shift >> 1) | ((value & 1) << 4));
+
+					if(complete) {
+						m_register[MAPPER_PRG_BANK(address)] = m_shift;
+						m_shift = MAPPER_MMC1_SHIFT;
+						select<TYPE>();
+					}
+				}
+				break;
+			case MAPPER_TYPE_MMC3:
+
+				switch(address & MAPPER_MMC3_REGISTER_MASK) {
+					case 0x8000:
+						m_select = value;
+						select<TYPE>();
+						break;
+					case 0x8001:
+						m_register[m_select & MAPPER_MMC3_SELECT_MASK] = value;
+						select<TYPE>();
+						break;
+					case 0xa000:
+
+						if(!MAPPER_FOUR_SCREEN(m_mirroring)) {
+							m_mirroring = ((value & 1) ? ROM_MIRRORING_HORIZONTAL : ROM_MIRRORING_VERTICAL);
+						}
+						break;
+					case MAPPER_MMC3_IRQ_LATCH:
+						m_irq_latch = value;
+						break;
+					case MAPPER_MMC3_IRQ_RELOAD:
+						m_irq_counter = 0;
+						m_irq_reload = true;
+						break;
+					case MAPPER_MMC3_IRQ_DISABLE:
+						m_irq_enable = false;
+						m_cpu.interrupt_release(INTERRUPT_LINE_MAPPER);
+						break;
+					case MAPPER_MMC3_IRQ_ENABLE:
+						m_irq_enable = true;
+						break;
+					default:
+						break;
+				}
+				break;
+			case MAPPER_TYPE_UXROM:
+				bank_prg(0, 2, value);
+				break;
+			default:
+				break;
+		}
+	}
+}
@@ -0,0 +1,386 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "../include/mirra_mmu.h"
+#include "mirra_mmu_type.h"
+
+namespace mirra {
+
+	#define MMU_FILL 0
+
+	mmu::mmu(void) :
+		mirra::singleton<mirra::mmu>(OBJECT_MMU),
+		m_generation(0),
+		m_handler(nullptr),
+		m_initialized(false),
+		m_started(false)
+	{
+		clear();
+	}
+
+	mmu::~mmu(void)
+	{
+		uninitialize();
+	}
+
+	void 
+	mmu::attach(
+		__in mirra::mmu_handler *handler
+		)
+	{
+		m_handler = handler;
+	}
+
+	void 
+	mmu::clear(void)
+	{
+		uint32_t iter;
+
+		++m_generation;
+
+		for(iter = 0; iter < MMU_CODE_COUNT; ++iter) {
+			m_code[iter] = 0;
+		}
+
+		m_port.clear();
+
+		for(iter = 0; iter < MMU_PAGE_COUNT; ++iter) {
+			m_bank[iter] = 0;
+			m_page[iter].read = nullptr;
+			m_page[iter].write = nullptr;
+			m_page[iter].handler = nullptr;
+		}
+	}
+
+	void 
+	mmu::code(
+		__in uint16_t address
+		)
+	{
+		uint32_t iter;
+		const uint8_t *write = m_page[MMU_PAGE(address)].write;
+
+		if(write) {
+
+			for(iter = 0; iter < MMU_PAGE_COUNT; ++iter) {
+
+				if(m_page[iter].write == write) {
+					m_code[iter >> MMU_CODE_WIDTH] |= (1U << (iter & MMU_CODE_MASK));
+				}
+			}
+		}
+	}
+
+	void 
+	mmu::detach(void)
+	{
+		m_handler = nullptr;
+	}
+
+	void 
+	mmu::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(m_initialized) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_INITIALIZED);
+		}
+
+		m_ram.resize(MMU_RAM_SIZE, MMU_FILL);
+		m_sram.resize(MMU_SRAM_SIZE, MMU_FILL);
+		m_initialized = true;
+	}
+
+	void 
+	mmu::invalidate(
+		__in uint16_t address
+		)
+	{
+		uint32_t iter;
+		const uint8_t *write = m_page[MMU_PAGE(address)].write;
+
+		for(iter = 0; iter < MMU_PAGE_COUNT; ++iter) {
+
+			if(MMU_CODE_CHECK(m_code, iter) && (m_page[iter].write == write)) {
+				m_code[iter >> MMU_CODE_WIDTH] &= ~(1U << (iter & MMU_CODE_MASK));
+
+				if(m_handler) {
+					m_handler->invalidate(iter << MMU_PAGE_WIDTH);
+				}
+			}
+		}
+
+		++m_generation;
+	}
+
+	bool 
+	mmu::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	mmu::is_started(void)
+	{
+		return m_started;
+	}
+
+	void 
+	mmu::map(
+		__in uint16_t address,
+		__in uint32_t length,
+		__in uint8_t *read,
+		__in uint8_t *write,
+		__in_opt mirra::bus *handler,
+		__in_opt uint16_t bank
+		)
+	{
+		uint32_t iter, offset = 0;
+
+		if(!m_initialized) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(!m_started) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_STOPPED);
+		}
+
+		if(MMU_PAGE_OFFSET(address)) {
+			THROW_MIRRA_MMU_EXCEPTION_FORMAT(MIRRA_MMU_EXCEPTION_INVALID_ALIGNMENT,
+				"%04x", address);
+		}
+
+		if(!length || MMU_PAGE_OFFSET(length) || ((address + length) > (BUS_WORD_MAX + 1))) {
+			THROW_MIRRA_MMU_EXCEPTION_FORMAT(MIRRA_MMU_EXCEPTION_INVALID_LENGTH,
+				"%04x, %x", address, length);
+		}
+
+		for(iter = MMU_PAGE(address); iter < MMU_PAGE(address + length); ++iter, offset += MMU_PAGE_SIZE) {
+			m_page[iter].read = (read ? (read + offset) : nullptr);
+			m_page[iter].write = (write ? (write + offset) : nullptr);
+			m_page[iter].handler = handler;
+			m_bank[iter] = bank;
+
+			if(MMU_CODE_CHECK(m_code, iter)) {
+				m_code[iter >> MMU_CODE_WIDTH] &= ~(1U << (iter & MMU_CODE_MASK));
+
+				if(m_handler) {
+					m_handler->invalidate(iter << MMU_PAGE_WIDTH);
+				}
+			}
+		}
+
+		++m_generation;
+	}
+
+	void 
+	mmu::map_port(
+		__in uint16_t address,
+		__in mirra::bus *handler
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(!m_started) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_STOPPED);
+		}
+
+		if((address < MMU_PORT_ADDRESS) || (address >= (MMU_PORT_ADDRESS + MMU_PORT_COUNT))) {
+			THROW_MIRRA_MMU_EXCEPTION_FORMAT(MIRRA_MMU_EXCEPTION_INVALID_PORT,
+				"%04x", address);
+		}
+
+		m_port.map(address, handler);
+	}
+
+	uint8_t *
+	mmu::ram(void)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_UNINITIALIZED);
+		}
+
+		return &m_ram[0];
+	}
+
+	void 
+	mmu::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+		uint32_t address;
+
+		if(!m_initialized) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_MMU_EXCEPTION(MIRRA_MMU_EXCEPTION_STARTED);
+		}
+
+		m_started = true;
+		std::fill(m_ram.begin(), m_ram.end(), MMU_FILL);
+		std::fill(m_sram.begin(), m_sram.end(), MMU_FILL);
+
+		for(address = MMU_RAM_ADDRESS; address < (MMU_RAM_ADDRESS + MMU_RAM_LENGTH); address += MMU_RAM_SIZE) {
+			map(address, MMU_RAM_SIZE, &m_ram[0], &m_ram[0]);
+		}
+
+		map(MMU_SRAM_ADDRESS, MMU_SRAM_SIZE, &m_sram[0], &m_sram[0]);
+		map(MMU_PORT_ADDRESS, MMU_PAGE_SIZE, nullptr, nullptr, &m_port);
+	}
+
+	void 
+	mmu::stop(void)
+	{
+
+		if(m_initialized && m_started) {
+			m_started = false;
+			clear();
+		}
+	}
+
+	std::string 
+	mmu::to_string(
+		__in_opt bool verbose
+		)
+	{
+		uint32_t iter, mapped = 0;
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this)
+				<< ", RAM=" << SCALAR_AS_HEX(uintptr_t, &m_ram[0]) << " (" << m_ram.size() << " bytes)";
+
+			if(m_started) {
+
+				for(iter = 0; iter < MMU_PAGE_COUNT; ++iter) {
+
+					if(m_page[iter].read || m_page[iter].write || m_page[iter].handler) {
+						++mapped;
+					}
+				}
+
+				result << ", PAGES=" << mapped << "/" << MMU_PAGE_COUNT;
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	mmu::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_ram.clear();
+			m_sram.clear();
+			m_initialized = false;
+		}
+	}
+
+	void 
+	mmu::unmap(
+		__in uint16_t address,
+		__in uint32_t length
+		)
+	{
+		map(address, length, nullptr, nullptr);
+	}
+
+	void 
+	mmu::unmap_port(
+		__in uint16_t address
+		)
+	{
+		map_port(address, nullptr);
+	}
+
+	mmu_port::mmu_port(void)
+	{
+		clear();
+	}
+
+	void 
+	mmu_port::clear(void)
+	{
+		uint32_t iter;
+
+		for(iter = 0; iter < MMU_PORT_COUNT; ++iter) {
+			m_handler[iter] = nullptr;
+		}
+	}
+
+	void 
+	mmu_port::map(
+		__in uint16_t address,
+		__in mirra::bus *handler
+		)
+	{
+		m_handler[address - MMU_PORT_ADDRESS] = handler;
+	}
+
+	uint8_t 
+	mmu_port::read(
+		__in uint16_t address
+		)
+	{
+		mirra::bus *handler = nullptr;
+
+		if((address - MMU_PORT_ADDRESS) < MMU_PORT_COUNT) {
+			handler = m_handler[address - MMU_PORT_ADDRESS];
+		}
+
+		return (handler ? handler->read(address) : MMU_PAGE(address));
+	}
+
+	void 
+	mmu_port::update(void)
+	{
+		return;
+	}
+
+	void 
+	mmu_port::write(
+		__in uint16_t address,
+		__in uint8_t value
+		)
+	{
+		mirra::bus *handler = nullptr;
+
+		if((address - MMU_PORT_ADDRESS) < MMU_PORT_COUNT) {
+			handler = m_handler[address - MMU_PORT_ADDRESS];
+		}
+
+		if(handler) {
+			handler->write(address, value);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_MMU_TYPE_H_
+#define MIRRA_MMU_TYPE_H_
+
+#include "../include/mirra_exception.h"
+
+namespace mirra {
+
+	#define MIRRA_MMU_HEADER "[MIRRA::MMU]"
+
+#ifndef NDEBUG
+	#define MIRRA_MMU_EXCEPTION_HEADER MIRRA_MMU_HEADER " "
+#else
+	#define MIRRA_MMU_EXCEPTION_HEADER
+#endif // NDEBUG
+
+	enum {
+		MIRRA_MMU_EXCEPTION_INITIALIZED = 0,
+		MIRRA_MMU_EXCEPTION_INVALID_ALIGNMENT,
+		MIRRA_MMU_EXCEPTION_INVALID_LENGTH,
+		MIRRA_MMU_EXCEPTION_INVALID_PORT,
+		MIRRA_MMU_EXCEPTION_STARTED,
+		MIRRA_MMU_EXCEPTION_STOPPED,
+		MIRRA_MMU_EXCEPTION_UNINITIALIZED,
+	};
+
+	#define MIRRA_MMU_EXCEPTION_MAX MIRRA_MMU_EXCEPTION_UNINITIALIZED
+
+	static const std::string MIRRA_MMU_EXCEPTION_STR[] = {
+		MIRRA_MMU_EXCEPTION_HEADER "MMU is initialized",
+		MIRRA_MMU_EXCEPTION_HEADER "Invalid page alignment",
+		MIRRA_MMU_EXCEPTION_HEADER "Invalid page length",
+		MIRRA_MMU_EXCEPTION_HEADER "Invalid port address",
+		MIRRA_MMU_EXCEPTION_HEADER "MMU is started",
+		MIRRA_MMU_EXCEPTION_HEADER "MMU is stopped",
+		MIRRA_MMU_EXCEPTION_HEADER "MMU is uninitialized",
+		};
+
+	#define MIRRA_MMU_EXCEPTION_STRING(_TYPE_) \
+		((_TYPE_) > MIRRA_MMU_EXCEPTION_MAX ? MIRRA_MMU_EXCEPTION_HEADER EXCEPTION_UNKNOWN : \
+		STRING_CHECK(MIRRA_MMU_EXCEPTION_STR[_TYPE_]))
+
+	#define THROW_MIRRA_MMU_EXCEPTION(_EXCEPT_) \
+		THROW_EXCEPTION(MIRRA_MMU_EXCEPTION_STRING(_EXCEPT_))
+	#define THROW_MIRRA_MMU_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+		THROW_EXCEPTION_FORMAT(MIRRA_MMU_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+}
+
+#endif // MIRRA_MMU_TYPE_H_
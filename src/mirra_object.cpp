@@ -23,8 +23,9 @@
 namespace mirra {
 
 	static const std::string OBJECT_STR[] = {
-		"APU", "BLOCK", "CPU", "DISPLAY", "INPUT",
-		"MAPPER", "MMU", "PPU", "ROM", "RUNTIME",
+		"APU", "BLOCK", "CPU", "DATABASE", "DISPLAY",
+		"INPUT", "MAPPER", "MMU", "PPU", "ROM",
+		"RUNTIME", "SCHEDULER", "TRACE",
 		};
 
 	#define OBJECT_STRING(_TYPE_) \
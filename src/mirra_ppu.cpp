@@ -0,0 +1,693 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+#include "../include/mirra_ppu.h"
+#include "mirra_ppu_type.h"
+
+namespace mirra {
+
+	#define PPU_ADDRESS 0x2000
+	#define PPU_ADDRESS_LENGTH 0x2000
+	#define PPU_ADDRESS_ATTRIBUTE 0x23c0
+	#define PPU_ADDRESS_MASK 0x3fff
+	#define PPU_ADDRESS_NAMETABLE 0x2000
+	#define PPU_ADDRESS_PALETTE 0x3f00
+
+	#define PPU_A12_DOT_BACKGROUND 324
+	#define PPU_A12_DOT_SPRITE 260
+
+	#define PPU_CONTROL_BACKGROUND 0x10
+	#define PPU_CONTROL_INCREMENT 0x04
+	#define PPU_CONTROL_NAMETABLE 0x03
+	#define PPU_CONTROL_NMI 0x80
+	#define PPU_CONTROL_SPRITE 0x08
+	#define PPU_CONTROL_SPRITE_TALL 0x20
+
+	#define PPU_DATA_INCREMENT(_CONTROL_) (((_CONTROL_) & PPU_CONTROL_INCREMENT) ? 32 : 1)
+
+	#define PPU_DMA_ADDRESS 0x4014
+	#define PPU_DMA_CYCLES 513
+
+	#define PPU_DOT(_DOT_) ((_DOT_) * SCHEDULER_PPU_DIVIDER)
+	#define PPU_DOT_RENDER 257
+
+	#define PPU_LINE_DOTS 341
+	#define PPU_LINE_COUNT 262
+	#define PPU_LINE_PRERENDER 261
+	#define PPU_LINE_VBLANK 241
+
+	#define PPU_MASK_BACKGROUND 0x08
+	#define PPU_MASK_BACKGROUND_LEFT 0x02
+	#define PPU_MASK_GRAYSCALE 0x01
+	#define PPU_MASK_RENDER (PPU_MASK_BACKGROUND | PPU_MASK_SPRITE)
+	#define PPU_MASK_SPRITE 0x10
+	#define PPU_MASK_SPRITE_LEFT 0x04
+
+	#define PPU_PALETTE_GRAYSCALE 0x30
+	#define PPU_PALETTE_INDEX 0x3f
+
+	#define PPU_SPRITE_BEHIND 0x40
+	#define PPU_SPRITE_COLOR 0x1f
+	#define PPU_SPRITE_COUNT 64
+	#define PPU_SPRITE_FLIP_HORIZONTAL 0x40
+	#define PPU_SPRITE_FLIP_VERTICAL 0x80
+	#define PPU_SPRITE_LINE 8
+	#define PPU_SPRITE_PALETTE 0x10
+	#define PPU_SPRITE_PRIORITY 0x20
+
+	#define PPU_STATUS_OVERFLOW 0x20
+	#define PPU_STATUS_SPRITE_HIT 0x40
+	#define PPU_STATUS_VBLANK 0x80
+
+	#define PPU_TABLE 0x1000
+	#define PPU_TILE_LENGTH 8
+	#define PPU_TILE_SIZE 16
+
+	#define PPU_VRAM_COARSE_X 0x001f
+	#define PPU_VRAM_COARSE_Y 0x03e0
+	#define PPU_VRAM_FINE_Y 0x7000
+	#define PPU_VRAM_HORIZONTAL 0x041f
+	#define PPU_VRAM_NAMETABLE_X 0x0400
+	#define PPU_VRAM_NAMETABLE_Y 0x0800
+	#define PPU_VRAM_VERTICAL 0x7be0
+
+	#define PPU_PIXEL(_LOW_, _HIGH_, _SHIFT_) \
+		((((_LOW_) >> (_SHIFT_)) & 1) | ((((_HIGH_) >> (_SHIFT_)) & 1) << 1))
+
+	static const uint32_t PPU_COLOR[] = {
+		RGB(84, 84, 84), RGB(0, 30, 116), RGB(8, 16, 144), RGB(48, 0, 136),
+		RGB(68, 0, 100), RGB(92, 0, 48), RGB(84, 4, 0), RGB(60, 24, 0),
+		RGB(32, 42, 0), RGB(8, 58, 0), RGB(0, 64, 0), RGB(0, 60, 0),
+		RGB(0, 50, 60), RGB(0, 0, 0), RGB(0, 0, 0), RGB(0, 0, 0),
+		RGB(152, 150, 152), RGB(8, 76, 196), RGB(48, 50, 236), RGB(92, 30, 228),
+		RGB(136, 20, 176), RGB(160, 20, 100), RGB(152, 34, 32), RGB(120, 60, 0),
+		RGB(84, 90, 0), RGB(40, 114, 0), RGB(8, 124, 0), RGB(0, 118, 40),
+		RGB(0, 102, 120), RGB(0, 0, 0), RGB(0, 0, 0), RGB(0, 0, 0),
+		RGB(236, 238, 236), RGB(76, 154, 236), RGB(120, 124, 236), RGB(176, 98, 236),
+		RGB(228, 84, 236), RGB(236, 88, 180), RGB(236, 106, 100), RGB(212, 136, 32),
+		RGB(160, 170, 0), RGB(116, 196, 0), RGB(76, 208, 32), RGB(56, 204, 108),
+		RGB(56, 180, 204), RGB(60, 60, 60), RGB(0, 0, 0), RGB(0, 0, 0),
+		RGB(236, 238, 236), RGB(168, 204, 236), RGB(188, 188, 236), RGB(212, 178, 236),
+		RGB(236, 174, 236), RGB(236, 174, 212), RGB(236, 180, 176), RGB(228, 196, 144),
+		RGB(204, 210, 120), RGB(180, 222, 120), RGB(168, 226, 144), RGB(152, 226, 180),
+		RGB(160, 214, 228), RGB(160, 162, 160), RGB(0, 0, 0), RGB(0, 0, 0),
+		};
+
+	ppu::ppu(void) :
+		mirra::singleton<mirra::ppu>(OBJECT_PPU),
+		m_cpu(mirra::cpu::acquire()),
+		m_display(mirra::display::acquire()),
+		m_initialized(false),
+		m_mapper(mirra::mapper::acquire()),
+		m_mmu(mirra::mmu::acquire()),
+		m_scheduler(mirra::scheduler::acquire()),
+		m_started(false)
+	{
+		clear();
+	}
+
+	ppu::~ppu(void)
+	{
+		uninitialize();
+	}
+
+	void 
+	ppu::clear(void)
+	{
+		m_address = 0;
+		m_address_temporary = 0;
+		m_buffer = 0;
+		m_control = 0;
+		m_cycle = 0;
+		m_edge = SCHEDULER_CYCLE_NEVER;
+		m_fine = 0;
+		std::memset(m_frame, 0, sizeof(m_frame));
+		m_frames = 0;
+		m_latch = 0;
+		m_line = 0;
+		m_mask = 0;
+		std::memset(m_oam, 0, sizeof(m_oam));
+		m_oam_address = 0;
+		std::memset(m_palette, 0, sizeof(m_palette));
+		m_skip = false;
+		m_status = 0;
+		m_toggle = false;
+		std::memset(m_vram, 0, sizeof(m_vram));
+	}
+
+	void 
+	ppu::fire(
+		__in mirra::scheduler_event_t event,
+		__in uint64_t cycle
+		)
+	{
+		synchronize(cycle);
+
+		switch(m_line) {
+			case PPU_LINE_VBLANK:
+				m_status |= PPU_STATUS_VBLANK;
+
+				if(m_control & PPU_CONTROL_NMI) {
+					m_cpu.interrupt_assert(INTERRUPT_LINE_NMI);
+				}
+
+				if(m_display.is_started()) {
+					m_display.present(m_frame, PPU_WIDTH, PPU_HEIGHT, PPU_COLOR);
+				}
+
+				m_cpu.raise(CPU_EVENT_FRAME);
+				break;
+			case PPU_LINE_PRERENDER:
+				m_status = 0;
+				m_skip = ((m_mask & PPU_MASK_RENDER) && (m_frames & 1));
+				m_cpu.interrupt_release(INTERRUPT_LINE_NMI);
+				break;
+			default:
+				break;
+		}
+
+		m_edge = SCHEDULER_CYCLE_NEVER;
+		predict(cycle);
+		m_scheduler.schedule(SCHEDULER_EVENT_PPU, m_cycle
+			+ PPU_DOT(PPU_LINE_DOTS - (((m_line == PPU_LINE_PRERENDER) && m_skip) ? 1 : 0) + 1));
+	}
+
+	void 
+	ppu::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(m_initialized) {
+			THROW_MIRRA_PPU_EXCEPTION(MIRRA_PPU_EXCEPTION_INITIALIZED);
+		}
+
+		clear();
+		m_initialized = true;
+	}
+
+	bool 
+	ppu::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	ppu::is_started(void)
+	{
+		return m_started;
+	}
+
+	uint8_t &
+	ppu::nametable(
+		__in uint16_t address
+		)
+	{
+		uint32_t table = ((address >> 10) & 3);
+
+		switch(m_mapper.mirroring()) {
+			case ROM_MIRRORING_HORIZONTAL:
+				table >>= 1;
+				break;
+			case ROM_MIRRORING_VERTICAL:
+				table &= 1;
+				break;
+			case ROM_MIRRORING_SINGLE_LOWER:
+				table = 0;
+				break;
+			case ROM_MIRRORING_SINGLE_UPPER:
+				table = 1;
+				break;
+			default:
+				break;
+		}
+
+		return m_vram[(table << 10) | (address & 0x03ff)];
+	}
+
+	uint8_t &
+	ppu::palette(
+		__in uint16_t address
+		)
+	{
+		address &= (PPU_PALETTE_SIZE - 1);
+
+		if((address & 0x13) == 0x10) {
+			address &= ~0x10;
+		}
+
+		return m_palette[address];
+	}
+
+	void 
+	ppu::predict(
+		__in uint64_t cycle
+		)
+	{
+		uint32_t line = m_line;
+		uint64_t base = m_cycle, edge = SCHEDULER_CYCLE_NEVER;
+
+		if(m_edge <= cycle) {
+			return;
+		}
+
+		if(cycle < m_cycle) {
+			line = (line ? (line - 1) : PPU_LINE_PRERENDER);
+			base -= PPU_DOT(PPU_LINE_DOTS - (((line == PPU_LINE_PRERENDER) && m_skip) ? 1 : 0));
+		}
+
+		if((m_mask & PPU_MASK_RENDER) && ((line < PPU_HEIGHT) || (line == PPU_LINE_PRERENDER))) {
+
+			if((m_control & PPU_CONTROL_SPRITE_TALL)
+					|| ((m_control & (PPU_CONTROL_BACKGROUND | PPU_CONTROL_SPRITE)) == PPU_CONTROL_SPRITE)) {
+				edge = (base + PPU_DOT(PPU_A12_DOT_SPRITE));
+			} else if((m_control & (PPU_CONTROL_BACKGROUND | PPU_CONTROL_SPRITE)) == PPU_CONTROL_BACKGROUND) {
+				edge = (base + PPU_DOT(PPU_A12_DOT_BACKGROUND));
+			}
+		}
+
+		if(edge <= cycle) {
+			edge = SCHEDULER_CYCLE_NEVER;
+		}
+
+		if(edge != SCHEDULER_CYCLE_NEVER) {
+			m_mapper.edge(edge);
+		} else if(m_edge != SCHEDULER_CYCLE_NEVER) {
+			m_scheduler.cancel(SCHEDULER_EVENT_MAPPER);
+		}
+
+		m_edge = edge;
+	}
+
+	uint8_t 
+	ppu::read(
+		__in uint16_t address
+		)
+	{
+
+		if(address == PPU_DMA_ADDRESS) {
+			return MMU_PAGE(address);
+		}
+
+		switch(address & PPU_REGISTER_MAX) {
+			case PPU_REGISTER_STATUS:
+				synchronize(m_scheduler.cycle());
+				m_latch = ((m_status & (PPU_STATUS_OVERFLOW | PPU_STATUS_SPRITE_HIT | PPU_STATUS_VBLANK))
+					| (m_latch & ~(PPU_STATUS_OVERFLOW | PPU_STATUS_SPRITE_HIT | PPU_STATUS_VBLANK)));
+				m_status &= ~PPU_STATUS_VBLANK;
+				m_toggle = false;
+				m_cpu.interrupt_release(INTERRUPT_LINE_NMI);
+				break;
+			case PPU_REGISTER_OAM_DATA:
+				m_latch = m_oam[m_oam_address];
+				break;
+			case PPU_REGISTER_DATA:
+				synchronize(m_scheduler.cycle());
+				address = (m_address & PPU_ADDRESS_MASK);
+
+				if(address >= PPU_ADDRESS_PALETTE) {
+					m_latch = palette(address);
+					m_buffer = read_data(address - PPU_TABLE);
+				} else {
+					m_latch = m_buffer;
+					m_buffer = read_data(address);
+				}
+
+				m_address += PPU_DATA_INCREMENT(m_control);
+				break;
+			default:
+				break;
+		}
+
+		return m_latch;
+	}
+
+	uint8_t 
+	ppu::read_data(
+		__in uint16_t address
+		)
+	{
+		uint8_t result;
+
+		address &= PPU_ADDRESS_MASK;
+
+		if(address < PPU_ADDRESS_NAMETABLE) {
+			result = m_mapper.read_chr(address);
+		} else if(address < PPU_ADDRESS_PALETTE) {
+			result = nametable(address);
+		} else {
+			result = palette(address);
+		}
+
+		return result;
+	}
+
+	void 
+	ppu::render(
+		__in uint32_t line
+		)
+	{
+		int32_t row;
+		const uint8_t *entry;
+		uint16_t address, table;
+		uint8_t attribute, high, low, tile, value;
+		uint8_t *pixel = &m_frame[line * PPU_WIDTH];
+		uint32_t count = 0, height, iter, shift, x;
+		uint8_t background[PPU_WIDTH + (2 * PPU_TILE_LENGTH)] = {}, sprite[PPU_WIDTH] = {};
+
+		if(m_mask & PPU_MASK_BACKGROUND) {
+			address = m_address;
+			table = ((m_control & PPU_CONTROL_BACKGROUND) ? PPU_TABLE : 0);
+
+			for(iter = 0; iter < (sizeof(background) / PPU_TILE_LENGTH); ++iter) {
+				tile = nametable(PPU_ADDRESS_NAMETABLE | (address & 0x0fff));
+				attribute = nametable(PPU_ADDRESS_ATTRIBUTE | (address & 0x0c00) | ((address >> 4) & 0x38) | ((address >> 2) & 0x07));
+				attribute = (((attribute >> (((address >> 4) & 4) | (address & 2))) & 3) << 2);
+				low = m_mapper.read_chr(table + (tile * PPU_TILE_SIZE) + ((address & PPU_VRAM_FINE_Y) >> 12));
+				high = m_mapper.read_chr(table + (tile * PPU_TILE_SIZE) + ((address & PPU_VRAM_FINE_Y) >> 12)
+					+ PPU_TILE_LENGTH);
+
+				for(x = 0; x < PPU_TILE_LENGTH; ++x) {
+					value = PPU_PIXEL(low, high, (PPU_TILE_LENGTH - 1) - x);
+					background[(iter * PPU_TILE_LENGTH) + x] = (value ? (attribute | value) : 0);
+				}
+
+				if((address & PPU_VRAM_COARSE_X) == PPU_VRAM_COARSE_X) {
+					address = ((address & ~PPU_VRAM_COARSE_X) ^ PPU_VRAM_NAMETABLE_X);
+				} else {
+					++address;
+				}
+			}
+
+			if(!(m_mask & PPU_MASK_BACKGROUND_LEFT)) {
+				std::memset(&background[m_fine], 0, PPU_TILE_LENGTH);
+			}
+		}
+
+		if(m_mask & PPU_MASK_SPRITE) {
+			height = ((m_control & PPU_CONTROL_SPRITE_TALL) ? (2 * PPU_TILE_LENGTH) : PPU_TILE_LENGTH);
+
+			for(iter = 0; iter < PPU_SPRITE_COUNT; ++iter) {
+				entry = &m_oam[iter * 4];
+
+				row = ((int32_t) line - (entry[0] + 1));
+				if((row < 0) || (row >= (int32_t) height)) {
+					continue;
+				}
+
+				if(++count > PPU_SPRITE_LINE) {
+					m_status |= PPU_STATUS_OVERFLOW;
+					break;
+				}
+
+				if(entry[2] & PPU_SPRITE_FLIP_VERTICAL) {
+					row = ((height - 1) - row);
+				}
+
+				if(height > PPU_TILE_LENGTH) {
+					table = ((entry[1] & 1) ? PPU_TABLE : 0);
+					tile = ((entry[1] & ~1) + (row >= PPU_TILE_LENGTH ? 1 : 0));
+					row &= (PPU_TILE_LENGTH - 1);
+				} else {
+					table = ((m_control & PPU_CONTROL_SPRITE) ? PPU_TABLE : 0);
+					tile = entry[1];
+				}
+
+				low = m_mapper.read_chr(table + (tile * PPU_TILE_SIZE) + row);
+				high = m_mapper.read_chr(table + (tile * PPU_TILE_SIZE) + row + PPU_TILE_LENGTH);
+
+				for(x = 0; (x < PPU_TILE_LENGTH) && ((entry[3] + x) < PPU_WIDTH); ++x) {
+					shift = ((entry[2] & PPU_SPRITE_FLIP_HORIZONTAL) ? x : ((PPU_TILE_LENGTH - 1) - x));
+
+					value = PPU_PIXEL(low, high, shift);
+					if(!value || sprite[entry[3] + x]
+							|| (((entry[3] + x) < PPU_TILE_LENGTH) && !(m_mask & PPU_MASK_SPRITE_LEFT))) {
+						continue;
+					}
+
+					if(!iter && background[entry[3] + x + m_fine] && ((entry[3] + x) < (PPU_WIDTH - 1))) {
+						m_status |= PPU_STATUS_SPRITE_HIT;
+					}
+
+					sprite[entry[3] + x] = (PPU_SPRITE_PALETTE | ((entry[2] & 3) << 2) | value
+						| ((entry[2] & PPU_SPRITE_PRIORITY) ? PPU_SPRITE_BEHIND : 0));
+				}
+			}
+		}
+
+		for(x = 0; x < PPU_WIDTH; ++x) {
+			value = background[x + m_fine];
+
+			if(sprite[x] && (!value || !(sprite[x] & PPU_SPRITE_BEHIND))) {
+				value = (sprite[x] & PPU_SPRITE_COLOR);
+			}
+
+			pixel[x] = (m_palette[value] & ((m_mask & PPU_MASK_GRAYSCALE) ? PPU_PALETTE_GRAYSCALE : PPU_PALETTE_INDEX));
+		}
+	}
+
+	void 
+	ppu::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_PPU_EXCEPTION(MIRRA_PPU_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_PPU_EXCEPTION(MIRRA_PPU_EXCEPTION_STARTED);
+		}
+
+		clear();
+		m_mmu.map(PPU_ADDRESS, PPU_ADDRESS_LENGTH, nullptr, nullptr, this);
+		m_mmu.map_port(PPU_DMA_ADDRESS, this);
+		m_cycle = m_scheduler.cycle();
+		m_scheduler.attach(SCHEDULER_EVENT_PPU, this);
+		m_scheduler.schedule(SCHEDULER_EVENT_PPU, m_cycle + PPU_DOT(1));
+		m_started = true;
+	}
+
+	void 
+	ppu::stop(void)
+	{
+
+		if(m_initialized && m_started) {
+			m_started = false;
+			m_scheduler.cancel(SCHEDULER_EVENT_PPU);
+			m_scheduler.detach(SCHEDULER_EVENT_PPU);
+			m_cpu.interrupt_release(INTERRUPT_LINE_NMI);
+
+			if(m_mmu.is_started()) {
+				m_mmu.unmap_port(PPU_DMA_ADDRESS);
+				m_mmu.unmap(PPU_ADDRESS, PPU_ADDRESS_LENGTH);
+			}
+
+			clear();
+		}
+	}
+
+	void 
+	ppu::synchronize(
+		__in uint64_t cycle
+		)
+	{
+		uint32_t coarse;
+
+		while((m_cycle + PPU_DOT(PPU_DOT_RENDER)) <= cycle) {
+
+			if(m_line < PPU_HEIGHT) {
+
+				if(m_mask & PPU_MASK_RENDER) {
+					render(m_line);
+				} else {
+					std::memset(&m_frame[m_line * PPU_WIDTH], m_palette[0], PPU_WIDTH);
+				}
+			}
+
+			if((m_mask & PPU_MASK_RENDER) && ((m_line < PPU_HEIGHT) || (m_line == PPU_LINE_PRERENDER))) {
+
+				if((m_address & PPU_VRAM_FINE_Y) != PPU_VRAM_FINE_Y) {
+					m_address += (1 << 12);
+				} else {
+					m_address &= ~PPU_VRAM_FINE_Y;
+					coarse = ((m_address & PPU_VRAM_COARSE_Y) >> 5);
+
+					if(coarse == 29) {
+						coarse = 0;
+						m_address ^= PPU_VRAM_NAMETABLE_Y;
+					} else if(coarse == 31) {
+						coarse = 0;
+					} else {
+						++coarse;
+					}
+
+					m_address = ((m_address & ~PPU_VRAM_COARSE_Y) | (coarse << 5));
+				}
+
+				m_address = ((m_address & ~PPU_VRAM_HORIZONTAL) | (m_address_temporary & PPU_VRAM_HORIZONTAL));
+
+				if(m_line == PPU_LINE_PRERENDER) {
+					m_address = ((m_address & ~PPU_VRAM_VERTICAL) | (m_address_temporary & PPU_VRAM_VERTICAL));
+				}
+			}
+
+			m_cycle += PPU_DOT(PPU_LINE_DOTS - (((m_line == PPU_LINE_PRERENDER) && m_skip) ? 1 : 0));
+
+			if(++m_line == PPU_LINE_COUNT) {
+				m_line = 0;
+				++m_frames;
+			}
+		}
+	}
+
+	std::string 
+	ppu::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this);
+
+			if(m_started) {
+				result << ", FRAME=" << m_frames << ", LINE=" << m_line
+					<< ", CTRL=" << SCALAR_AS_HEX(uint8_t, m_control)
+					<< ", MASK=" << SCALAR_AS_HEX(uint8_t, m_mask)
+					<< ", STAT=" << SCALAR_AS_HEX(uint8_t, m_status)
+					<< ", V=" << SCALAR_AS_HEX(uint16_t, m_address)
+					<< ", T=" << SCALAR_AS_HEX(uint16_t, m_address_temporary)
+					<< ", X=" << (uint32_t) m_fine;
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	ppu::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_initialized = false;
+		}
+	}
+
+	void 
+	ppu::write(
+		__in uint16_t address,
+		__in uint8_t value
+		)
+	{
+		uint32_t iter;
+
+		if(address == PPU_DMA_ADDRESS) {
+
+			for(iter = 0; iter < PPU_OAM_SIZE; ++iter) {
+				m_oam[(uint8_t) (m_oam_address + iter)] = m_mmu.read((value << 8) | iter);
+			}
+
+			m_cpu.stall(PPU_DMA_CYCLES + (m_cpu.cycles() & 1));
+			return;
+		}
+
+		synchronize(m_scheduler.cycle());
+		m_latch = value;
+
+		switch(address & PPU_REGISTER_MAX) {
+			case PPU_REGISTER_CONTROL:
+
+				if((value & PPU_CONTROL_NMI) && !(m_control & PPU_CONTROL_NMI) && (m_status & PPU_STATUS_VBLANK)) {
+					m_cpu.interrupt_assert(INTERRUPT_LINE_NMI);
+				} else if(!(value & PPU_CONTROL_NMI)) {
+					m_cpu.interrupt_release(INTERRUPT_LINE_NMI);
+				}
+
+				m_control = value;
+				m_address_temporary = ((m_address_temporary & ~(PPU_VRAM_NAMETABLE_X | PPU_VRAM_NAMETABLE_Y))
+					| ((value & PPU_CONTROL_NAMETABLE) << 10));
+				predict(m_scheduler.cycle());
+				break;
+			case PPU_REGISTER_MASK:
+				m_mask = value;
+				predict(m_scheduler.cycle());
+				break;
+			case PPU_REGISTER_OAM_ADDRESS:
+				m_oam_address = value;
+				break;
+			case PPU_REGISTER_OAM_DATA:
+				m_oam[m_oam_address++] = value;
+				break;
+			case PPU_REGISTER_SCROLL:
+
+				if(!m_toggle) {
+					m_address_temporary = ((m_address_temporary & ~PPU_VRAM_COARSE_X) | (value >> 3));
+					m_fine = (value & (PPU_TILE_LENGTH - 1));
+				} else {
+					m_address_temporary = ((m_address_temporary & ~(PPU_VRAM_COARSE_Y | PPU_VRAM_FINE_Y))
+						| ((value & 0xf8) << 2) | ((value & 0x07) << 12));
+				}
+
+				m_toggle = !m_toggle;
+				break;
+			case PPU_REGISTER_ADDRESS:
+
+				if(!m_toggle) {
+					m_address_temporary = ((m_address_temporary & 0x00ff) | ((value & 0x3f) << 8));
+				} else {
+					m_address_temporary = ((m_address_temporary & 0xff00) | value);
+					m_address = m_address_temporary;
+				}
+
+				m_toggle = !m_toggle;
+				break;
+			case PPU_REGISTER_DATA:
+				write_data(m_address, value);
+				m_address += PPU_DATA_INCREMENT(m_control);
+				break;
+			default:
+				break;
+		}
+	}
+
+	void 
+	ppu::write_data(
+		__in uint16_t address,
+		__in uint8_t value
+		)
+	{
+		address &= PPU_ADDRESS_MASK;
+
+		if(address < PPU_ADDRESS_NAMETABLE) {
+			m_mapper.write_chr(address, value);
+		} else if(address < PPU_ADDRESS_PALETTE) {
+			nametable(address) = value;
+		} else {
+			palette(address) = (value & PPU_PALETTE_INDEX);
+		}
+	}
+}
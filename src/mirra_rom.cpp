@@ -0,0 +1,1539 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/mirra_rom.h"
+#include "mirra_rom_type.h"
+
+namespace mirra {
+
+	static const std::string ROM_FORMAT_STR[] = {
+		"INES", "NES2",
+		};
+
+	#define ROM_FORMAT_STRING(_TYPE_) \
+		((_TYPE_) > ROM_FORMAT_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(ROM_FORMAT_STR[_TYPE_]))
+
+	static const std::string ROM_MIRRORING_STR[] = {
+		"HORIZONTAL", "VERTICAL", "FOUR_SCREEN", "SINGLE_LOWER", "SINGLE_UPPER",
+		};
+
+	#define ROM_MIRRORING_STRING(_TYPE_) \
+		((_TYPE_) > ROM_MIRRORING_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(ROM_MIRRORING_STR[_TYPE_]))
+
+	static const std::string ROM_PARAMETER_STR[] = {
+		"CACHE", "PATCH", "PATH",
+		};
+
+	#define ROM_PARAMETER_STRING(_TYPE_) \
+		((_TYPE_) > ROM_PARAMETER_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(ROM_PARAMETER_STR[_TYPE_]))
+
+	static const std::string ROM_REGION_STR[] = {
+		"NTSC", "PAL", "MULTIPLE", "DENDY",
+		};
+
+	#define ROM_REGION_STRING(_TYPE_) \
+		((_TYPE_) > ROM_REGION_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(ROM_REGION_STR[_TYPE_]))
+
+	static const uint8_t ROM_MAGIC[] = {
+		'N', 'E', 'S', 0x1a,
+		};
+
+	#define ROM_ARCHIVE_EXTENSION ".nes"
+	#define ROM_ARCHIVE_GZIP_FLAG_COMMENT 0x10
+	#define ROM_ARCHIVE_GZIP_FLAG_CRC 0x02
+	#define ROM_ARCHIVE_GZIP_FLAG_EXTRA 0x04
+	#define ROM_ARCHIVE_GZIP_FLAG_NAME 0x08
+	#define ROM_ARCHIVE_GZIP_FLAG_OFFSET 3
+	#define ROM_ARCHIVE_GZIP_HEADER 10
+	#define ROM_ARCHIVE_GZIP_MAGIC 0x8b1f
+	#define ROM_ARCHIVE_GZIP_METHOD_OFFSET 2
+	#define ROM_ARCHIVE_GZIP_TRAILER (2 * sizeof(uint32_t))
+	#define ROM_ARCHIVE_MAGIC_LENGTH 4
+	#define ROM_ARCHIVE_MEMORY "mirra_rom"
+	#define ROM_ARCHIVE_METHOD_DEFLATE 8
+	#define ROM_ARCHIVE_METHOD_STORE 0
+	#define ROM_ARCHIVE_TEMPORARY ".XXXXXX"
+	#define ROM_ARCHIVE_ZIP_CENTRAL 0x02014b50
+	#define ROM_ARCHIVE_ZIP_CENTRAL_COMMENT 32
+	#define ROM_ARCHIVE_ZIP_CENTRAL_COMPRESSED 20
+	#define ROM_ARCHIVE_ZIP_CENTRAL_CRC 16
+	#define ROM_ARCHIVE_ZIP_CENTRAL_EXTRA 30
+	#define ROM_ARCHIVE_ZIP_CENTRAL_FLAG 8
+	#define ROM_ARCHIVE_ZIP_CENTRAL_LENGTH 46
+	#define ROM_ARCHIVE_ZIP_CENTRAL_LOCAL 42
+	#define ROM_ARCHIVE_ZIP_CENTRAL_METHOD 10
+	#define ROM_ARCHIVE_ZIP_CENTRAL_NAME 28
+	#define ROM_ARCHIVE_ZIP_CENTRAL_SIZE 24
+	#define ROM_ARCHIVE_ZIP_END 0x06054b50
+	#define ROM_ARCHIVE_ZIP_END_COUNT 10
+	#define ROM_ARCHIVE_ZIP_END_LENGTH 22
+	#define ROM_ARCHIVE_ZIP_END_OFFSET 16
+	#define ROM_ARCHIVE_ZIP_FLAG_ENCRYPTED 0x01
+	#define ROM_ARCHIVE_ZIP_LOCAL 0x04034b50
+	#define ROM_ARCHIVE_ZIP_LOCAL_EXTRA 28
+	#define ROM_ARCHIVE_ZIP_LOCAL_LENGTH 30
+	#define ROM_ARCHIVE_ZIP_LOCAL_NAME 26
+
+	#define ROM_ARCHIVE_EXTENSION_MATCH(_NAME_) \
+		(((_NAME_).size() >= (sizeof(ROM_ARCHIVE_EXTENSION) - 1)) \
+			&& !strcasecmp(&(_NAME_)[(_NAME_).size() - (sizeof(ROM_ARCHIVE_EXTENSION) - 1)], \
+				ROM_ARCHIVE_EXTENSION))
+	#define ROM_ARCHIVE_READ_16(_DATA_) \
+		((_DATA_)[0] | ((_DATA_)[1] << 8))
+	#define ROM_ARCHIVE_READ_32(_DATA_) \
+		(ROM_ARCHIVE_READ_16(_DATA_) | ((uint32_t) ROM_ARCHIVE_READ_16(&(_DATA_)[2]) << 16))
+
+	#define ROM_FLAG_BATTERY 0x02
+	#define ROM_FLAG_FOUR_SCREEN 0x08
+	#define ROM_FLAG_NES2 0x08
+	#define ROM_FLAG_NES2_MASK 0x0c
+	#define ROM_FLAG_PAL 0x01
+	#define ROM_FLAG_TRAINER 0x04
+	#define ROM_FLAG_VERTICAL 0x01
+	#define ROM_INFLATE_BLOCK_DYNAMIC 2
+	#define ROM_INFLATE_BLOCK_END 256
+	#define ROM_INFLATE_BLOCK_FIXED 1
+	#define ROM_INFLATE_BLOCK_STORED 0
+	#define ROM_INFLATE_CODE_REPEAT 16
+	#define ROM_INFLATE_CODE_SYMBOLS 19
+	#define ROM_INFLATE_CODE_ZERO 17
+	#define ROM_INFLATE_DISTANCE_CODES 30
+	#define ROM_INFLATE_DISTANCE_SYMBOLS 32
+	#define ROM_INFLATE_LENGTH_SYMBOLS 29
+
+	#define ROM_INFLATE_FILL(_STATE_) \
+		while(((_STATE_).count <= 56) && ((_STATE_).position < (_STATE_).length)) { \
+			(_STATE_).buffer |= ((uint64_t) (_STATE_).data[(_STATE_).position++] << (_STATE_).count); \
+			(_STATE_).count += 8; \
+		}
+
+	static constexpr uint16_t ROM_INFLATE_DISTANCE_BASE[] = {
+		1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+		};
+
+	static constexpr uint8_t ROM_INFLATE_DISTANCE_EXTRA[] = {
+		0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+		};
+
+	static constexpr uint16_t ROM_INFLATE_LENGTH_BASE[] = {
+		3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+		};
+
+	static constexpr uint8_t ROM_INFLATE_LENGTH_EXTRA[] = {
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+		};
+
+	static constexpr uint8_t ROM_INFLATE_ORDER[] = {
+		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+		};
+
+	#define ROM_PATCH_BPS "BPS1"
+	#define ROM_PATCH_BPS_SOURCE_COPY 2
+	#define ROM_PATCH_BPS_SOURCE_READ 0
+	#define ROM_PATCH_BPS_TARGET_COPY 3
+	#define ROM_PATCH_BPS_TARGET_READ 1
+	#define ROM_PATCH_DELIMITER ':'
+	#define ROM_PATCH_FOOTER (3 * sizeof(uint32_t))
+	#define ROM_PATCH_IPS "PATCH"
+	#define ROM_PATCH_IPS_EOF 0x454f46
+	#define ROM_PATCH_UPS "UPS1"
+
+	#define ROM_PATCH_FORMAT(_DATA_, _MAGIC_) \
+		(((_DATA_).size() >= (sizeof(_MAGIC_) - 1)) \
+			&& !std::memcmp(&(_DATA_)[0], _MAGIC_, sizeof(_MAGIC_) - 1))
+	#define ROM_PATCH_READ_16(_DATA_, _POSITION_) \
+		(((_DATA_)[_POSITION_] << 8) | (_DATA_)[(_POSITION_) + 1])
+	#define ROM_PATCH_READ_24(_DATA_, _POSITION_) \
+		(((_DATA_)[_POSITION_] << 16) | ROM_PATCH_READ_16(_DATA_, (_POSITION_) + 1))
+	#define ROM_PATCH_READ_32(_DATA_, _POSITION_) \
+		((_DATA_)[_POSITION_] | ((_DATA_)[(_POSITION_) + 1] << 8) \
+			| ((_DATA_)[(_POSITION_) + 2] << 16) | ((uint32_t) (_DATA_)[(_POSITION_) + 3] << 24))
+	#define ROM_PATCH_WRITE(_TARGET_, _OFFSET_, _VALUE_) \
+		if((_TARGET_)[_OFFSET_] != (_VALUE_)) { \
+			(_TARGET_)[_OFFSET_] = (_VALUE_); \
+		}
+
+	#define ROM_SIZE_EXPONENT 0x0f
+	#define ROM_SIZE_EXPONENT_MAX 30
+
+	rom::rom(void) :
+		mirra::singleton<mirra::rom>(OBJECT_ROM),
+		m_base(nullptr),
+		m_initialized(false),
+		m_length(0),
+		m_started(false)
+	{
+		clear();
+	}
+
+	rom::~rom(void)
+	{
+		uninitialize();
+	}
+
+	bool 
+	rom::apply(
+		__in const std::vector<uint8_t> &data,
+		__in uint8_t *target,
+		__in size_t reserve,
+		__inout size_t &length,
+		__in_opt const uint8_t *source
+		)
+	{
+		bool result = false;
+
+		if(ROM_PATCH_FORMAT(data, ROM_PATCH_BPS)) {
+			result = patch_bps(data, target, reserve, length, source);
+		} else if(ROM_PATCH_FORMAT(data, ROM_PATCH_IPS)) {
+			result = patch_ips(data, target, reserve, length);
+		} else if(ROM_PATCH_FORMAT(data, ROM_PATCH_UPS)) {
+			result = patch_ups(data, target, reserve, length);
+		}
+
+		return result;
+	}
+
+	void 
+	rom::clear(void)
+	{
+		m_archive = false;
+		m_battery = false;
+		m_cache.clear();
+		m_chr = nullptr;
+		m_chr_size = 0;
+		m_corrected = false;
+		m_format = ROM_FORMAT_INES;
+		m_mapper = 0;
+		m_mirroring = ROM_MIRRORING_HORIZONTAL;
+		m_patch = 0;
+		m_path.clear();
+		m_prg = nullptr;
+		m_prg_size = 0;
+		m_region = ROM_REGION_NTSC;
+		m_submapper = 0;
+		m_trainer = nullptr;
+	}
+
+	void 
+	rom::correct(void)
+	{
+		mirra::database_key_t key;
+		mirra::database_hash_t hash;
+		mirra::database_entry_t entry;
+		mirra::database &database = mirra::database::acquire();
+
+		if(database.is_started() && database.is_loaded()) {
+			database.hash_begin(hash);
+			database.hash_update(hash, m_prg, m_prg_size);
+
+			if(m_chr) {
+				database.hash_update(hash, m_chr, m_chr_size);
+			}
+
+			database.hash_end(hash, key);
+
+			if(database.find(key, entry)) {
+				m_battery = entry.battery;
+				m_mapper = entry.mapper;
+				m_submapper = entry.submapper;
+
+				if(entry.mirroring <= ROM_MIRRORING_FOUR_SCREEN) {
+					m_mirroring = (mirra::rom_mirroring_t) entry.mirroring;
+				}
+
+				if(entry.region <= ROM_REGION_MAX) {
+					m_region = (mirra::rom_region_t) entry.region;
+				}
+
+				m_corrected = true;
+			}
+		}
+	}
+
+	int 
+	rom::extract(
+		__in int handle,
+		__in const std::string &path,
+		__inout size_t &length
+		)
+	{
+		int result;
+		void *target;
+		struct stat status;
+		bool valid = false;
+		std::string name, temporary;
+		std::stringstream stream;
+		mirra::database_key_t key;
+		mirra::database_hash_t hash;
+		const uint8_t *base, *data = nullptr, *entry;
+		uint8_t magic[ROM_ARCHIVE_MAGIC_LENGTH] = {};
+		uint32_t checksum = 0, count, iter, method = ROM_ARCHIVE_METHOD_DEFLATE;
+		size_t compressed = 0, end, offset = ROM_ARCHIVE_GZIP_HEADER, position = 0, size = 0;
+
+		if((pread(handle, magic, sizeof(magic), 0) != sizeof(magic))
+				|| ((ROM_ARCHIVE_READ_16(magic) != ROM_ARCHIVE_GZIP_MAGIC)
+					&& (ROM_ARCHIVE_READ_32(magic) != ROM_ARCHIVE_ZIP_LOCAL))) {
+			return handle;
+		}
+
+		base = (const uint8_t *) mmap(nullptr, length, PROT_READ, MAP_SHARED, handle, 0);
+		if(base == MAP_FAILED) {
+			close(handle);
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_EXTERNAL,
+				"%s: %s", path.c_str(), std::strerror(errno));
+		}
+
+		if(ROM_ARCHIVE_READ_16(magic) == ROM_ARCHIVE_GZIP_MAGIC) {
+
+			if((length >= (ROM_ARCHIVE_GZIP_HEADER + ROM_ARCHIVE_GZIP_TRAILER))
+					&& (base[ROM_ARCHIVE_GZIP_METHOD_OFFSET] == ROM_ARCHIVE_METHOD_DEFLATE)) {
+				end = (length - ROM_ARCHIVE_GZIP_TRAILER);
+
+				if((base[ROM_ARCHIVE_GZIP_FLAG_OFFSET] & ROM_ARCHIVE_GZIP_FLAG_EXTRA) && ((offset + 2) <= end)) {
+					offset += (2 + ROM_ARCHIVE_READ_16(&base[offset]));
+				}
+
+				if(base[ROM_ARCHIVE_GZIP_FLAG_OFFSET] & ROM_ARCHIVE_GZIP_FLAG_NAME) {
+					for(; (offset < end) && base[offset]; ++offset);
+					++offset;
+				}
+
+				if(base[ROM_ARCHIVE_GZIP_FLAG_OFFSET] & ROM_ARCHIVE_GZIP_FLAG_COMMENT) {
+					for(; (offset < end) && base[offset]; ++offset);
+					++offset;
+				}
+
+				if(base[ROM_ARCHIVE_GZIP_FLAG_OFFSET] & ROM_ARCHIVE_GZIP_FLAG_CRC) {
+					offset += 2;
+				}
+
+				if(offset <= end) {
+					data = &base[offset];
+					compressed = (end - offset);
+					checksum = ROM_ARCHIVE_READ_32(&base[end]);
+					size = ROM_ARCHIVE_READ_32(&base[end + sizeof(uint32_t)]);
+				}
+			}
+		} else if(length >= ROM_ARCHIVE_ZIP_END_LENGTH) {
+
+			for(end = (length - ROM_ARCHIVE_ZIP_END_LENGTH); end
+					&& ((length - end) <= (ROM_ARCHIVE_ZIP_END_LENGTH + UINT16_MAX)); --end) {
+
+				if(ROM_ARCHIVE_READ_32(&base[end]) == ROM_ARCHIVE_ZIP_END) {
+					break;
+				}
+			}
+
+			count = ROM_ARCHIVE_READ_16(&base[end + ROM_ARCHIVE_ZIP_END_COUNT]);
+			offset = ROM_ARCHIVE_READ_32(&base[end + ROM_ARCHIVE_ZIP_END_OFFSET]);
+
+			for(iter = 0; (ROM_ARCHIVE_READ_32(&base[end]) == ROM_ARCHIVE_ZIP_END) && (iter < count); ++iter) {
+
+				if(((offset + ROM_ARCHIVE_ZIP_CENTRAL_LENGTH) > end)
+						|| (ROM_ARCHIVE_READ_32(&base[offset]) != ROM_ARCHIVE_ZIP_CENTRAL)) {
+					break;
+				}
+
+				entry = &base[offset];
+				name.assign((const char *) &entry[ROM_ARCHIVE_ZIP_CENTRAL_LENGTH],
+					std::min((size_t) ROM_ARCHIVE_READ_16(&entry[ROM_ARCHIVE_ZIP_CENTRAL_NAME]),
+						end - offset - ROM_ARCHIVE_ZIP_CENTRAL_LENGTH));
+				offset += (ROM_ARCHIVE_ZIP_CENTRAL_LENGTH + name.size()
+					+ ROM_ARCHIVE_READ_16(&entry[ROM_ARCHIVE_ZIP_CENTRAL_EXTRA])
+					+ ROM_ARCHIVE_READ_16(&entry[ROM_ARCHIVE_ZIP_CENTRAL_COMMENT]));
+
+				if(name.empty() || (name.back() == '/') || (data && !ROM_ARCHIVE_EXTENSION_MATCH(name))) {
+					continue;
+				}
+
+				position = ROM_ARCHIVE_READ_32(&entry[ROM_ARCHIVE_ZIP_CENTRAL_LOCAL]);
+				if(((position + ROM_ARCHIVE_ZIP_LOCAL_LENGTH) > length)
+						|| (ROM_ARCHIVE_READ_32(&base[position]) != ROM_ARCHIVE_ZIP_LOCAL)
+						|| (ROM_ARCHIVE_READ_16(&entry[ROM_ARCHIVE_ZIP_CENTRAL_FLAG]) & ROM_ARCHIVE_ZIP_FLAG_ENCRYPTED)) {
+					data = nullptr;
+					break;
+				}
+
+				position += (ROM_ARCHIVE_ZIP_LOCAL_LENGTH + ROM_ARCHIVE_READ_16(&base[position + ROM_ARCHIVE_ZIP_LOCAL_NAME])
+					+ ROM_ARCHIVE_READ_16(&base[position + ROM_ARCHIVE_ZIP_LOCAL_EXTRA]));
+				data = base;
+				method = ROM_ARCHIVE_READ_16(&entry[ROM_ARCHIVE_ZIP_CENTRAL_METHOD]);
+				checksum = ROM_ARCHIVE_READ_32(&entry[ROM_ARCHIVE_ZIP_CENTRAL_CRC]);
+				compressed = ROM_ARCHIVE_READ_32(&entry[ROM_ARCHIVE_ZIP_CENTRAL_COMPRESSED]);
+				size = ROM_ARCHIVE_READ_32(&entry[ROM_ARCHIVE_ZIP_CENTRAL_SIZE]);
+
+				if(ROM_ARCHIVE_EXTENSION_MATCH(name)) {
+					break;
+				}
+			}
+
+			if(data && (position <= length) && (compressed <= (length - position))) {
+				data = &base[position];
+			} else {
+				data = nullptr;
+			}
+		}
+
+		if(!data || !size || ((method != ROM_ARCHIVE_METHOD_DEFLATE) && (method != ROM_ARCHIVE_METHOD_STORE))) {
+			munmap((void *) base, length);
+			close(handle);
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_ARCHIVE,
+				"%s", path.c_str());
+		}
+
+		if(!m_cache.empty()) {
+			mirra::database &instance = mirra::database::acquire();
+
+			instance.hash_begin(hash);
+			instance.hash_update(hash, base, length);
+			instance.hash_end(hash, key);
+
+			stream << m_cache << "/" << std::hex << std::setfill('0');
+
+			for(iter = 0; iter < DATABASE_SHA1_LENGTH; ++iter) {
+				stream << std::setw(2) << (uint32_t) key.sha1[iter];
+			}
+
+			stream << ROM_ARCHIVE_EXTENSION;
+			name = stream.str();
+
+			result = open(name.c_str(), O_RDONLY);
+			if(result >= 0) {
+
+				if(!fstat(result, &status) && status.st_size) {
+					munmap((void *) base, length);
+					close(handle);
+					length = status.st_size;
+					m_archive = true;
+					return result;
+				}
+
+				close(result);
+			}
+
+			temporary = (name + ROM_ARCHIVE_TEMPORARY);
+			result = mkstemp(&temporary[0]);
+		} else {
+			result = memfd_create(ROM_ARCHIVE_MEMORY, 0);
+		}
+
+		if(result < 0) {
+			munmap((void *) base, length);
+			close(handle);
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_EXTERNAL,
+				"%s: %s", path.c_str(), std::strerror(errno));
+		}
+
+		if(!ftruncate(result, size)) {
+
+			target = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, result, 0);
+			if(target != MAP_FAILED) {
+
+				if(method == ROM_ARCHIVE_METHOD_STORE) {
+					valid = (compressed == size);
+
+					if(valid) {
+						std::memcpy(target, data, size);
+					}
+				} else {
+					valid = inflate(data, compressed, (uint8_t *) target, size);
+				}
+
+				valid = (valid && (mirra::database::acquire().checksum((const uint8_t *) target, size) == checksum));
+				munmap(target, size);
+			}
+		}
+
+		munmap((void *) base, length);
+		close(handle);
+
+		if(!valid) {
+			close(result);
+
+			if(!temporary.empty()) {
+				unlink(temporary.c_str());
+			}
+
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_ARCHIVE,
+				"%s", path.c_str());
+		}
+
+		if(!temporary.empty() && rename(temporary.c_str(), name.c_str())) {
+			unlink(temporary.c_str());
+		}
+
+		length = size;
+		m_archive = true;
+
+		return result;
+	}
+
+	bool 
+	rom::inflate(
+		__in const uint8_t *data,
+		__in size_t length,
+		__in uint8_t *target,
+		__in size_t size
+		)
+	{
+		uint32_t complement, count, final, iter, type;
+		mirra::rom_inflate_t state = {};
+		uint8_t code[ROM_HUFFMAN_SYMBOLS + ROM_INFLATE_DISTANCE_SYMBOLS];
+		mirra::rom_huffman_t distance, literal, fixed_distance, fixed_literal;
+
+		state.data = data;
+		state.length = length;
+		state.target = target;
+		state.size = size;
+
+		for(iter = 0; iter < ROM_HUFFMAN_SYMBOLS; ++iter) {
+			code[iter] = ((iter < 144) ? 8 : ((iter < 256) ? 9 : ((iter < 280) ? 7 : 8)));
+		}
+
+		std::memset(&code[ROM_HUFFMAN_SYMBOLS], 5, ROM_INFLATE_DISTANCE_SYMBOLS);
+		inflate_build(fixed_literal, code, ROM_HUFFMAN_SYMBOLS);
+		inflate_build(fixed_distance, &code[ROM_HUFFMAN_SYMBOLS], ROM_INFLATE_DISTANCE_SYMBOLS);
+
+		do {
+
+			if(!inflate_bits(state, 1, final) || !inflate_bits(state, 2, type)) {
+				return false;
+			}
+
+			switch(type) {
+				case ROM_INFLATE_BLOCK_STORED:
+					state.buffer >>= (state.count & 7);
+					state.count &= ~7;
+
+					if(!inflate_bits(state, 16, count) || !inflate_bits(state, 16, complement)
+							|| (count != (~complement & UINT16_MAX)) || (count > (state.size - state.output))) {
+						return false;
+					}
+
+					for(; count && state.count; --count, state.count -= 8, state.buffer >>= 8) {
+						state.target[state.output++] = state.buffer;
+					}
+
+					if(count > (state.length - state.position)) {
+						return false;
+					}
+
+					std::memcpy(&state.target[state.output], &state.data[state.position], count);
+					state.output += count;
+					state.position += count;
+					break;
+				case ROM_INFLATE_BLOCK_FIXED:
+
+					if(!inflate_block(state, fixed_literal, fixed_distance)) {
+						return false;
+					}
+					break;
+				case ROM_INFLATE_BLOCK_DYNAMIC:
+
+					if(!inflate_dynamic(state, literal, distance)
+							|| !inflate_block(state, literal, distance)) {
+						return false;
+					}
+					break;
+				default:
+					return false;
+			}
+		} while(!final);
+
+		return (state.output == state.size);
+	}
+
+	bool 
+	rom::inflate_bits(
+		__inout mirra::rom_inflate_t &state,
+		__in uint32_t count,
+		__out uint32_t &value
+		)
+	{
+
+		ROM_INFLATE_FILL(state);
+
+		if(UNLIKELY(state.count < count)) {
+			return false;
+		}
+
+		value = (state.buffer & ((UINT64_C(1) << count) - 1));
+		state.buffer >>= count;
+		state.count -= count;
+
+		return true;
+	}
+
+	bool 
+	rom::inflate_block(
+		__inout mirra::rom_inflate_t &state,
+		__in const mirra::rom_huffman_t &literal,
+		__in const mirra::rom_huffman_t &distance
+		)
+	{
+		size_t offset;
+		uint32_t count, extra, symbol;
+
+		for(;;) {
+
+			if(!inflate_decode(state, literal, symbol)) {
+				return false;
+			}
+
+			if(symbol < ROM_INFLATE_BLOCK_END) {
+
+				if(UNLIKELY(state.output >= state.size)) {
+					return false;
+				}
+
+				state.target[state.output++] = symbol;
+				continue;
+			} else if(symbol == ROM_INFLATE_BLOCK_END) {
+				break;
+			}
+
+			symbol -= (ROM_INFLATE_BLOCK_END + 1);
+			if((symbol >= ROM_INFLATE_LENGTH_SYMBOLS)
+					|| !inflate_bits(state, ROM_INFLATE_LENGTH_EXTRA[symbol], extra)) {
+				return false;
+			}
+
+			count = (ROM_INFLATE_LENGTH_BASE[symbol] + extra);
+
+			if(!inflate_decode(state, distance, symbol) || (symbol >= ROM_INFLATE_DISTANCE_CODES)
+					|| !inflate_bits(state, ROM_INFLATE_DISTANCE_EXTRA[symbol], extra)) {
+				return false;
+			}
+
+			offset = (ROM_INFLATE_DISTANCE_BASE[symbol] + extra);
+
+			if(UNLIKELY((offset > state.output) || (count > (state.size - state.output)))) {
+				return false;
+			}
+
+			for(; count; --count, ++state.output) {
+				state.target[state.output] = state.target[state.output - offset];
+			}
+		}
+
+		return true;
+	}
+
+	bool 
+	rom::inflate_build(
+		__out mirra::rom_huffman_t &huffman,
+		__in const uint8_t *length,
+		__in uint32_t count
+		)
+	{
+		int32_t left = 1;
+		uint32_t code, fill, iter;
+		uint16_t next[ROM_HUFFMAN_BITS + 1], offset[ROM_HUFFMAN_BITS + 1];
+
+		std::memset(&huffman, 0, sizeof(huffman));
+
+		for(iter = 0; iter < count; ++iter) {
+			++huffman.count[length[iter]];
+		}
+
+		huffman.count[0] = 0;
+
+		for(iter = 1; iter <= ROM_HUFFMAN_BITS; ++iter) {
+			left = ((left << 1) - huffman.count[iter]);
+
+			if(left < 0) {
+				return false;
+			}
+		}
+
+		offset[1] = 0;
+		next[1] = 0;
+
+		for(iter = 1; iter < ROM_HUFFMAN_BITS; ++iter) {
+			offset[iter + 1] = (offset[iter] + huffman.count[iter]);
+			next[iter + 1] = ((next[iter] + huffman.count[iter]) << 1);
+		}
+
+		for(iter = 0; iter < count; ++iter) {
+
+			if(!length[iter]) {
+				continue;
+			}
+
+			huffman.symbol[offset[length[iter]]++] = iter;
+
+			if(length[iter] <= ROM_HUFFMAN_FAST) {
+
+				for(code = 0, fill = 0; fill < length[iter]; ++fill) {
+					code |= (((next[length[iter]] >> fill) & 1) << (length[iter] - fill - 1));
+				}
+
+				for(; code < (1 << ROM_HUFFMAN_FAST); code += (1 << length[iter])) {
+					huffman.fast[code] = ((iter << 4) | length[iter]);
+				}
+			}
+
+			++next[length[iter]];
+		}
+
+		return true;
+	}
+
+	bool 
+	rom::inflate_decode(
+		__inout mirra::rom_inflate_t &state,
+		__in const mirra::rom_huffman_t &huffman,
+		__out uint32_t &symbol
+		)
+	{
+		uint16_t entry;
+		uint32_t code = 0, first = 0, index = 0, iter;
+
+		if(state.count < ROM_HUFFMAN_BITS) {
+			ROM_INFLATE_FILL(state);
+		}
+
+		entry = huffman.fast[state.buffer & ((1 << ROM_HUFFMAN_FAST) - 1)];
+		if(LIKELY(entry && ((entry & 0xf) <= state.count))) {
+			symbol = (entry >> 4);
+			state.buffer >>= (entry & 0xf);
+			state.count -= (entry & 0xf);
+			return true;
+		}
+
+		for(iter = 1; (iter <= ROM_HUFFMAN_BITS) && (iter <= state.count); ++iter) {
+			code |= ((state.buffer >> (iter - 1)) & 1);
+
+			if((code - first) < huffman.count[iter]) {
+				symbol = huffman.symbol[index + (code - first)];
+				state.buffer >>= iter;
+				state.count -= iter;
+				return true;
+			}
+
+			index += huffman.count[iter];
+			first = ((first + huffman.count[iter]) << 1);
+			code <<= 1;
+		}
+
+		return false;
+	}
+
+	bool 
+	rom::inflate_dynamic(
+		__inout mirra::rom_inflate_t &state,
+		__out mirra::rom_huffman_t &literal,
+		__out mirra::rom_huffman_t &distance
+		)
+	{
+		mirra::rom_huffman_t huffman;
+		uint32_t count, iter = 0, length, lengths, literals, distances, repeat, symbol;
+		uint8_t code[ROM_HUFFMAN_SYMBOLS + ROM_INFLATE_DISTANCE_SYMBOLS] = {};
+
+		if(!inflate_bits(state, 5, literals) || !inflate_bits(state, 5, distances)
+				|| !inflate_bits(state, 4, lengths)) {
+			return false;
+		}
+
+		literals += (ROM_INFLATE_BLOCK_END + 1);
+		distances += 1;
+		lengths += 4;
+
+		if((literals > ROM_HUFFMAN_SYMBOLS) || (distances > ROM_INFLATE_DISTANCE_SYMBOLS)) {
+			return false;
+		}
+
+		for(; iter < lengths; ++iter) {
+
+			if(!inflate_bits(state, 3, length)) {
+				return false;
+			}
+
+			code[ROM_INFLATE_ORDER[iter]] = length;
+		}
+
+		if(!inflate_build(huffman, code, ROM_INFLATE_CODE_SYMBOLS)) {
+			return false;
+		}
+
+		for(iter = 0; iter < (literals + distances);) {
+
+			if(!inflate_decode(state, huffman, symbol)) {
+				return false;
+			}
+
+			if(symbol < ROM_INFLATE_CODE_REPEAT) {
+				code[iter++] = symbol;
+				continue;
+			}
+
+			switch(symbol) {
+				case ROM_INFLATE_CODE_REPEAT:
+
+					if(!iter || !inflate_bits(state, 2, repeat)) {
+						return false;
+					}
+
+					length = code[iter - 1];
+					count = (repeat + 3);
+					break;
+				case ROM_INFLATE_CODE_ZERO:
+
+					if(!inflate_bits(state, 3, repeat)) {
+						return false;
+					}
+
+					length = 0;
+					count = (repeat + 3);
+					break;
+				default:
+
+					if(!inflate_bits(state, 7, repeat)) {
+						return false;
+					}
+
+					length = 0;
+					count = (repeat + 11);
+					break;
+			}
+
+			if(count > ((literals + distances) - iter)) {
+				return false;
+			}
+
+			std::memset(&code[iter], length, count);
+			iter += count;
+		}
+
+		if(!code[ROM_INFLATE_BLOCK_END]) {
+			return false;
+		}
+
+		std::memmove(&code[ROM_HUFFMAN_SYMBOLS], &code[literals], distances);
+		std::memset(&code[literals], 0, ROM_HUFFMAN_SYMBOLS - literals);
+		std::memset(&code[ROM_HUFFMAN_SYMBOLS + distances], 0, ROM_INFLATE_DISTANCE_SYMBOLS - distances);
+
+		return (inflate_build(literal, code, ROM_HUFFMAN_SYMBOLS)
+			&& inflate_build(distance, &code[ROM_HUFFMAN_SYMBOLS], ROM_INFLATE_DISTANCE_SYMBOLS));
+	}
+
+	void 
+	rom::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(m_initialized) {
+			THROW_MIRRA_ROM_EXCEPTION(MIRRA_ROM_EXCEPTION_INITIALIZED);
+		}
+
+		m_initialized = true;
+	}
+
+	bool 
+	rom::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	rom::is_loaded(void)
+	{
+		return (m_base != nullptr);
+	}
+
+	bool 
+	rom::is_started(void)
+	{
+		return m_started;
+	}
+
+	void 
+	rom::load(
+		__in const std::string &path,
+		__in const std::vector<std::string> &patch
+		)
+	{
+		int handle;
+		bool trainer;
+		struct stat status;
+		uint32_t iter;
+		std::ifstream file;
+		std::vector<uint8_t> snapshot;
+		const uint8_t *original, *source;
+		std::vector<std::vector<uint8_t>> data;
+		void *result = MAP_FAILED, *shared = MAP_FAILED;
+		size_t length, reserve, size, offset = sizeof(mirra::rom_header_t);
+
+		data.resize(patch.size());
+
+		for(iter = 0; iter < patch.size(); ++iter) {
+			file.open(patch[iter].c_str(), std::ios::in | std::ios::binary);
+			if(!file) {
+				THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_EXTERNAL,
+					"%s", patch[iter].c_str());
+			}
+
+			data[iter].assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			file.close();
+		}
+
+		handle = open(path.c_str(), O_RDONLY);
+		if(handle < 0) {
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_EXTERNAL,
+				"%s: %s", path.c_str(), std::strerror(errno));
+		}
+
+		if(fstat(handle, &status) || !status.st_size) {
+			close(handle);
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_LENGTH,
+				"%s", path.c_str());
+		}
+
+		size = status.st_size;
+		handle = extract(handle, path, size);
+		length = size;
+		reserve = length;
+
+		for(iter = 0; iter < data.size(); ++iter) {
+
+			if(!apply(data[iter], nullptr, 0, length)) {
+				close(handle);
+				THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_PATCH,
+					"%s", patch[iter].c_str());
+			}
+
+			reserve = std::max(reserve, length);
+		}
+
+		length = size;
+
+		if(data.empty()) {
+			result = mmap(nullptr, length, PROT_READ, MAP_SHARED, handle, 0);
+		} else {
+			result = mmap(nullptr, reserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+			if((result != MAP_FAILED) && (mmap(result, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+					handle, 0) == MAP_FAILED)) {
+				munmap(result, reserve);
+				result = MAP_FAILED;
+			}
+
+			if(result != MAP_FAILED) {
+				shared = mmap(nullptr, length, PROT_READ, MAP_SHARED, handle, 0);
+			}
+		}
+
+		close(handle);
+
+		if((result == MAP_FAILED) || (!data.empty() && (shared == MAP_FAILED))) {
+
+			if(result != MAP_FAILED) {
+				munmap(result, reserve);
+			}
+
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_EXTERNAL,
+				"%s: %s", path.c_str(), std::strerror(errno));
+		}
+
+		m_base = (uint8_t *) result;
+		m_length = reserve;
+		m_path = path;
+
+		if(!data.empty()) {
+			original = (const uint8_t *) shared;
+
+			for(iter = 0; iter < data.size(); ++iter) {
+				source = original;
+
+				if(iter && ROM_PATCH_FORMAT(data[iter], ROM_PATCH_BPS)) {
+					snapshot.assign(m_base, m_base + length);
+					source = &snapshot[0];
+				}
+
+				if(!apply(data[iter], m_base, reserve, length, source)) {
+					munmap(shared, size);
+					unload();
+					THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_PATCH,
+						"%s", patch[iter].c_str());
+				}
+
+				original = nullptr;
+			}
+
+			munmap(shared, size);
+			mprotect(m_base, reserve, PROT_READ);
+			m_patch = data.size();
+		}
+
+		if((length < sizeof(mirra::rom_header_t)) || !parse(*(const mirra::rom_header_t *) m_base)) {
+			unload();
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_HEADER,
+				"%s", path.c_str());
+		}
+
+		trainer = (((const mirra::rom_header_t *) m_base)->flag_6 & ROM_FLAG_TRAINER);
+		if((offset + (trainer ? ROM_TRAINER_SIZE : 0) + m_prg_size + m_chr_size) > length) {
+			unload();
+			THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_LENGTH,
+				"%s: %u bytes", path.c_str(), (uint32_t) length);
+		}
+
+		if(trainer) {
+			m_trainer = &m_base[offset];
+			offset += ROM_TRAINER_SIZE;
+		}
+
+		m_prg = &m_base[offset];
+		offset += m_prg_size;
+		m_chr = (m_chr_size ? &m_base[offset] : nullptr);
+		correct();
+	}
+
+	bool 
+	rom::parse(
+		__in const mirra::rom_header_t &header
+		)
+	{
+		uint64_t chr, prg;
+
+		if(std::memcmp(header.magic, ROM_MAGIC, sizeof(ROM_MAGIC))) {
+			return false;
+		}
+
+		m_format = (((header.flag_7 & ROM_FLAG_NES2_MASK) == ROM_FLAG_NES2) ? ROM_FORMAT_NES2 : ROM_FORMAT_INES);
+		m_battery = (header.flag_6 & ROM_FLAG_BATTERY);
+		m_mapper = (header.flag_6 >> 4);
+
+		if(header.flag_6 & ROM_FLAG_FOUR_SCREEN) {
+			m_mirroring = ROM_MIRRORING_FOUR_SCREEN;
+		} else {
+			m_mirroring = ((header.flag_6 & ROM_FLAG_VERTICAL) ? ROM_MIRRORING_VERTICAL : ROM_MIRRORING_HORIZONTAL);
+		}
+
+		if(m_format == ROM_FORMAT_NES2) {
+			m_mapper |= ((header.flag_7 & 0xf0) | ((header.flag_8 & 0x0f) << 8));
+			m_submapper = (header.flag_8 >> 4);
+			m_region = (mirra::rom_region_t) (header.flag_12 & 0x03);
+
+			if((header.flag_9 & 0x0f) == ROM_SIZE_EXPONENT) {
+
+				if((header.prg >> 2) > ROM_SIZE_EXPONENT_MAX) {
+					return false;
+				}
+
+				prg = ((1ULL << (header.prg >> 2)) * (((header.prg & 3) * 2) + 1));
+			} else {
+				prg = ((((header.flag_9 & 0x0f) << 8) | header.prg) * (uint64_t) ROM_BANK_PRG_SIZE);
+			}
+
+			if((header.flag_9 >> 4) == ROM_SIZE_EXPONENT) {
+
+				if((header.chr >> 2) > ROM_SIZE_EXPONENT_MAX) {
+					return false;
+				}
+
+				chr = ((1ULL << (header.chr >> 2)) * (((header.chr & 3) * 2) + 1));
+			} else {
+				chr = ((((header.flag_9 >> 4) << 8) | header.chr) * (uint64_t) ROM_BANK_CHR_SIZE);
+			}
+		} else {
+
+			if(!header.flag_12 && !header.flag_13 && !header.flag_14 && !header.flag_15) {
+				m_mapper |= (header.flag_7 & 0xf0);
+			}
+
+			m_submapper = 0;
+			m_region = ((header.flag_9 & ROM_FLAG_PAL) ? ROM_REGION_PAL : ROM_REGION_NTSC);
+			prg = (header.prg * (uint64_t) ROM_BANK_PRG_SIZE);
+			chr = (header.chr * (uint64_t) ROM_BANK_CHR_SIZE);
+		}
+
+		if(!prg || (prg % ROM_BANK_PRG_SIZE) || (prg > UINT32_MAX)
+				|| (chr % ROM_BANK_CHR_SIZE) || (chr > UINT32_MAX)) {
+			return false;
+		}
+
+		m_prg_size = prg;
+		m_chr_size = chr;
+
+		return true;
+	}
+
+	bool 
+	rom::patch_bps(
+		__in const std::vector<uint8_t> &data,
+		__in uint8_t *target,
+		__in size_t reserve,
+		__inout size_t &length,
+		__in_opt const uint8_t *source
+		)
+	{
+		uint64_t command, count, metadata, relative, size_source, size_target;
+		size_t end, iter, output = 0, position = (sizeof(ROM_PATCH_BPS) - 1), offset_source = 0, offset_target = 0;
+
+		if(data.size() < (position + ROM_PATCH_FOOTER)) {
+			return false;
+		}
+
+		end = (data.size() - ROM_PATCH_FOOTER);
+
+		if(!patch_decode(data, position, end, size_source) || !patch_decode(data, position, end, size_target)
+				|| !patch_decode(data, position, end, metadata) || (metadata > (end - position))) {
+			return false;
+		}
+
+		position += metadata;
+
+		if(!target) {
+			length = size_target;
+			return true;
+		}
+
+		if(!source || (size_source != length) || (size_target > reserve)
+				|| (mirra::database::acquire().checksum(source, length) != ROM_PATCH_READ_32(data, end))) {
+			return false;
+		}
+
+		while(position < end) {
+
+			if(!patch_decode(data, position, end, command)) {
+				return false;
+			}
+
+			count = ((command >> 2) + 1);
+			if(count > (size_target - output)) {
+				return false;
+			}
+
+			switch(command & 3) {
+				case ROM_PATCH_BPS_SOURCE_READ:
+
+					if((output + count) > size_source) {
+						return false;
+					}
+
+					for(iter = 0; iter < count; ++iter) {
+						ROM_PATCH_WRITE(target, output + iter, source[output + iter]);
+					}
+					break;
+				case ROM_PATCH_BPS_TARGET_READ:
+
+					if(count > (end - position)) {
+						return false;
+					}
+
+					for(iter = 0; iter < count; ++iter) {
+						ROM_PATCH_WRITE(target, output + iter, data[position + iter]);
+					}
+
+					position += count;
+					break;
+				default:
+
+					if(!patch_decode(data, position, end, relative)) {
+						return false;
+					}
+
+					if((command & 3) == ROM_PATCH_BPS_SOURCE_COPY) {
+						offset_source = ((relative & 1) ? (offset_source - (relative >> 1)) : (offset_source + (relative >> 1)));
+
+						if((offset_source > size_source) || (count > (size_source - offset_source))) {
+							return false;
+						}
+
+						for(iter = 0; iter < count; ++iter) {
+							ROM_PATCH_WRITE(target, output + iter, source[offset_source + iter]);
+						}
+
+						offset_source += count;
+					} else {
+						offset_target = ((relative & 1) ? (offset_target - (relative >> 1)) : (offset_target + (relative >> 1)));
+
+						if(offset_target >= output) {
+							return false;
+						}
+
+						for(iter = 0; iter < count; ++iter) {
+							ROM_PATCH_WRITE(target, output + iter, target[offset_target + iter]);
+						}
+
+						offset_target += count;
+					}
+					break;
+			}
+
+			output += count;
+		}
+
+		if(output != size_target) {
+			return false;
+		}
+
+		length = size_target;
+
+		return (mirra::database::acquire().checksum(target, length)
+			== ROM_PATCH_READ_32(data, end + sizeof(uint32_t)));
+	}
+
+	bool 
+	rom::patch_decode(
+		__in const std::vector<uint8_t> &data,
+		__inout size_t &position,
+		__in size_t end,
+		__out uint64_t &value
+		)
+	{
+		uint8_t byte;
+		uint64_t shift = 1;
+
+		value = 0;
+
+		for(;;) {
+
+			if((position >= end) || (shift >> 56)) {
+				return false;
+			}
+
+			byte = data[position++];
+			value += ((byte & 0x7f) * shift);
+
+			if(byte & 0x80) {
+				break;
+			}
+
+			shift <<= 7;
+			value += shift;
+		}
+
+		return true;
+	}
+
+	bool 
+	rom::patch_ips(
+		__in const std::vector<uint8_t> &data,
+		__in uint8_t *target,
+		__in size_t reserve,
+		__inout size_t &length
+		)
+	{
+		size_t count, iter, offset, position = (sizeof(ROM_PATCH_IPS) - 1);
+
+		for(;;) {
+
+			if((position + 3) > data.size()) {
+				return false;
+			}
+
+			offset = ROM_PATCH_READ_24(data, position);
+			position += 3;
+
+			if(offset == ROM_PATCH_IPS_EOF) {
+				break;
+			}
+
+			if((position + 2) > data.size()) {
+				return false;
+			}
+
+			count = ROM_PATCH_READ_16(data, position);
+			position += 2;
+
+			if(count) {
+
+				if((position + count) > data.size()) {
+					return false;
+				}
+
+				if(target) {
+
+					if((offset + count) > reserve) {
+						return false;
+					}
+
+					for(iter = 0; iter < count; ++iter) {
+						ROM_PATCH_WRITE(target, offset + iter, data[position + iter]);
+					}
+				}
+
+				position += count;
+			} else {
+
+				if((position + 3) > data.size()) {
+					return false;
+				}
+
+				count = ROM_PATCH_READ_16(data, position);
+
+				if(target) {
+
+					if((offset + count) > reserve) {
+						return false;
+					}
+
+					for(iter = 0; iter < count; ++iter) {
+						ROM_PATCH_WRITE(target, offset + iter, data[position + 2]);
+					}
+				}
+
+				position += 3;
+			}
+
+			length = std::max(length, offset + count);
+		}
+
+		if((position + 3) <= data.size()) {
+			length = ROM_PATCH_READ_24(data, position);
+		}
+
+		return true;
+	}
+
+	bool 
+	rom::patch_ups(
+		__in const std::vector<uint8_t> &data,
+		__in uint8_t *target,
+		__in size_t reserve,
+		__inout size_t &length
+		)
+	{
+		uint8_t value;
+		uint64_t offset = 0, relative, size_source, size_target;
+		size_t end, position = (sizeof(ROM_PATCH_UPS) - 1);
+
+		if(data.size() < (position + ROM_PATCH_FOOTER)) {
+			return false;
+		}
+
+		end = (data.size() - ROM_PATCH_FOOTER);
+
+		if(!patch_decode(data, position, end, size_source) || !patch_decode(data, position, end, size_target)) {
+			return false;
+		}
+
+		if(!target) {
+			length = size_target;
+			return true;
+		}
+
+		if((size_source != length) || (size_target > reserve)
+				|| (mirra::database::acquire().checksum(target, length) != ROM_PATCH_READ_32(data, end))) {
+			return false;
+		}
+
+		while(position < end) {
+
+			if(!patch_decode(data, position, end, relative)) {
+				return false;
+			}
+
+			for(offset += relative;; ++offset) {
+
+				if(position >= end) {
+					return false;
+				}
+
+				value = data[position++];
+				if(!value) {
+					++offset;
+					break;
+				}
+
+				if(offset >= reserve) {
+					return false;
+				}
+
+				target[offset] ^= value;
+			}
+		}
+
+		length = size_target;
+
+		return (mirra::database::acquire().checksum(target, length)
+			== ROM_PATCH_READ_32(data, end + sizeof(uint32_t)));
+	}
+
+	void 
+	rom::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+		std::string path, value;
+		std::stringstream stream;
+		std::vector<std::string> patch;
+		mirra::parameter_t::const_iterator iter;
+		mirra::object_parameter_t::const_iterator attribute_iter;
+
+		if(!m_initialized) {
+			THROW_MIRRA_ROM_EXCEPTION(MIRRA_ROM_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_ROM_EXCEPTION(MIRRA_ROM_EXCEPTION_STARTED);
+		}
+
+		clear();
+
+		iter = parameter.find(OBJECT_ROM);
+		if(iter != parameter.end()) {
+
+			attribute_iter = iter->second.find(ROM_PARAMETER_CACHE);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_STRING)
+						|| !attribute_iter->second.data.strvalue) {
+					THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s)", ROM_PARAMETER_STRING(ROM_PARAMETER_CACHE),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_STRING));
+				}
+
+				m_cache = attribute_iter->second.data.strvalue;
+			}
+
+			attribute_iter = iter->second.find(ROM_PARAMETER_PATCH);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_STRING)
+						|| !attribute_iter->second.data.strvalue) {
+					THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s)", ROM_PARAMETER_STRING(ROM_PARAMETER_PATCH),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_STRING));
+				}
+
+				stream << attribute_iter->second.data.strvalue;
+
+				while(std::getline(stream, value, ROM_PATCH_DELIMITER)) {
+
+					if(!value.empty()) {
+						patch.push_back(value);
+					}
+				}
+			}
+
+			attribute_iter = iter->second.find(ROM_PARAMETER_PATH);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_STRING)
+						|| !attribute_iter->second.data.strvalue) {
+					THROW_MIRRA_ROM_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s)", ROM_PARAMETER_STRING(ROM_PARAMETER_PATH),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_STRING));
+				}
+
+				path = attribute_iter->second.data.strvalue;
+			}
+		}
+
+		if(!path.empty()) {
+			load(path, patch);
+		}
+
+		m_started = true;
+	}
+
+	void 
+	rom::stop(void)
+	{
+
+		if(m_initialized && m_started) {
+			m_started = false;
+			unload();
+		}
+	}
+
+	std::string 
+	rom::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this);
+
+			if(m_started && is_loaded()) {
+				result << ", PATH=" << m_path
+					<< ", BASE=" << SCALAR_AS_HEX(uintptr_t, m_base) << " (" << m_length << " bytes)"
+					<< ", FMT=" << ROM_FORMAT_STRING(m_format)
+					<< ", MAP=" << m_mapper << "." << (uint32_t) m_submapper
+					<< ", PRG=" << m_prg_size << " bytes"
+					<< ", CHR=" << m_chr_size << " bytes"
+					<< ", MIRR=" << ROM_MIRRORING_STRING(m_mirroring)
+					<< ", REG=" << ROM_REGION_STRING(m_region)
+					<< (m_battery ? ", BATT" : "")
+					<< (m_trainer ? ", TRAIN" : "")
+					<< (m_corrected ? ", DB" : "")
+					<< (m_archive ? ", ARCH" : "");
+
+				if(m_patch) {
+					result << ", PATCH=" << m_patch;
+				}
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	rom::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_initialized = false;
+		}
+	}
+
+	void 
+	rom::unload(void)
+	{
+
+		if(m_base) {
+			munmap(m_base, m_length);
+			m_base = nullptr;
+			m_length = 0;
+		}
+
+		clear();
+	}
+}
@@ -0,0 +1,73 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_ROM_TYPE_H_
+#define MIRRA_ROM_TYPE_H_
+
+#include "../include/mirra_exception.h"
+
+namespace mirra {
+
+	#define MIRRA_ROM_HEADER "[MIRRA::ROM]"
+
+#ifndef NDEBUG
+	#define MIRRA_ROM_EXCEPTION_HEADER MIRRA_ROM_HEADER " "
+#else
+	#define MIRRA_ROM_EXCEPTION_HEADER
+#endif // NDEBUG
+
+	enum {
+		MIRRA_ROM_EXCEPTION_EXTERNAL = 0,
+		MIRRA_ROM_EXCEPTION_INITIALIZED,
+		MIRRA_ROM_EXCEPTION_INVALID_ARCHIVE,
+		MIRRA_ROM_EXCEPTION_INVALID_HEADER,
+		MIRRA_ROM_EXCEPTION_INVALID_LENGTH,
+		MIRRA_ROM_EXCEPTION_INVALID_PARAMETER,
+		MIRRA_ROM_EXCEPTION_INVALID_PATCH,
+		MIRRA_ROM_EXCEPTION_STARTED,
+		MIRRA_ROM_EXCEPTION_STOPPED,
+		MIRRA_ROM_EXCEPTION_UNINITIALIZED,
+	};
+
+	#define MIRRA_ROM_EXCEPTION_MAX MIRRA_ROM_EXCEPTION_UNINITIALIZED
+
+	static const std::string MIRRA_ROM_EXCEPTION_STR[] = {
+		MIRRA_ROM_EXCEPTION_HEADER "External exception",
+		MIRRA_ROM_EXCEPTION_HEADER "ROM is initialized",
+		MIRRA_ROM_EXCEPTION_HEADER "Invalid ROM archive",
+		MIRRA_ROM_EXCEPTION_HEADER "Invalid ROM header",
+		MIRRA_ROM_EXCEPTION_HEADER "Invalid ROM length",
+		MIRRA_ROM_EXCEPTION_HEADER "Invalid parameter type",
+		MIRRA_ROM_EXCEPTION_HEADER "Invalid ROM patch",
+		MIRRA_ROM_EXCEPTION_HEADER "ROM is started",
+		MIRRA_ROM_EXCEPTION_HEADER "ROM is stopped",
+		MIRRA_ROM_EXCEPTION_HEADER "ROM is uninitialized",
+		};
+
+	#define MIRRA_ROM_EXCEPTION_STRING(_TYPE_) \
+		((_TYPE_) > MIRRA_ROM_EXCEPTION_MAX ? MIRRA_ROM_EXCEPTION_HEADER EXCEPTION_UNKNOWN : \
+		STRING_CHECK(MIRRA_ROM_EXCEPTION_STR[_TYPE_]))
+
+	#define THROW_MIRRA_ROM_EXCEPTION(_EXCEPT_) \
+		THROW_EXCEPTION(MIRRA_ROM_EXCEPTION_STRING(_EXCEPT_))
+	#define THROW_MIRRA_ROM_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+		THROW_EXCEPTION_FORMAT(MIRRA_ROM_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+}
+
+#endif // MIRRA_ROM_TYPE_H_
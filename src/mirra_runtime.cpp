@@ -20,6 +20,12 @@
 #include <functional>
 #include "../include/mirra_runtime.h"
 #include "../include/mirra_cpu.h"
+#include "../include/mirra_database.h"
+#include "../include/mirra_mapper.h"
+#include "../include/mirra_mmu.h"
+#include "../include/mirra_ppu.h"
+#include "../include/mirra_rom.h"
+#include "../include/mirra_scheduler.h"
 #include "mirra_runtime_type.h"
 
 namespace mirra {
@@ -71,7 +77,16 @@ namespace mirra {
 		m_parameter_initialize = parameter;
 		mirra::display::acquire().initialize(m_parameter_initialize);
 		mirra::input::acquire().initialize(m_parameter_initialize);
+		mirra::mmu::acquire().initialize(m_parameter_initialize);
+		mirra::database::acquire().initialize(m_parameter_initialize);
+		mirra::rom::acquire().initialize(m_parameter_initialize);
+		mirra::mapper::acquire().initialize(m_parameter_initialize);
+		mirra::ppu::acquire().initialize(m_parameter_initialize);
 		mirra::cpu::acquire().initialize(m_parameter_initialize);
+		mirra::scheduler::acquire().initialize(m_parameter_initialize);
+#if TRACE >= TRACE_INSTRUCTION
+		mirra::trace::acquire().initialize(m_parameter_initialize);
+#endif // TRACE >= TRACE_INSTRUCTION
 
 		// TODO: initialize sigletons
 
@@ -98,6 +113,15 @@ namespace mirra {
 	{
 		SDL_Event event;
 		mirra::cpu &cpu = mirra::cpu::acquire();
+		mirra::mmu &mmu = mirra::mmu::acquire();
+		mirra::database &database = mirra::database::acquire();
+		mirra::rom &rom = mirra::rom::acquire();
+		mirra::mapper &mapper = mirra::mapper::acquire();
+		mirra::ppu &ppu = mirra::ppu::acquire();
+		mirra::scheduler &scheduler = mirra::scheduler::acquire();
+#if TRACE >= TRACE_INSTRUCTION
+		mirra::trace &trace = mirra::trace::acquire();
+#endif // TRACE >= TRACE_INSTRUCTION
 		mirra::input &input = mirra::input::acquire();
 		mirra::display &display = mirra::display::acquire();
 
@@ -112,7 +136,16 @@ namespace mirra {
 
 		display.start(context.m_parameter_start);
 		input.start(context.m_parameter_start);
+		mmu.start(context.m_parameter_start);
+		scheduler.start(context.m_parameter_start);
+		database.start(context.m_parameter_start);
+		rom.start(context.m_parameter_start);
+		mapper.start(context.m_parameter_start);
+		ppu.start(context.m_parameter_start);
 		cpu.start(context.m_parameter_start);
+#if TRACE >= TRACE_INSTRUCTION
+		trace.start(context.m_parameter_start);
+#endif // TRACE >= TRACE_INSTRUCTION
 
 		// TODO: start singletons
 
@@ -134,13 +167,22 @@ namespace mirra {
 			}
 
 			// TODO: update singletons
-			//cpu.update();
+			scheduler.run_until(CPU_EVENT_FRAME);
 			// ---
 		}
 
 		// TODO: stop singletons
 
+#if TRACE >= TRACE_INSTRUCTION
+		trace.stop();
+#endif // TRACE >= TRACE_INSTRUCTION
 		cpu.stop();
+		ppu.stop();
+		mapper.stop();
+		rom.stop();
+		database.stop();
+		scheduler.stop();
+		mmu.stop();
 		input.stop();
 		display.stop();
 		SDL_Quit();
@@ -231,7 +273,16 @@ namespace mirra {
 
 			// TODO: uninitialize singletons
 
+#if TRACE >= TRACE_INSTRUCTION
+			mirra::trace::acquire().uninitialize();
+#endif // TRACE >= TRACE_INSTRUCTION
+			mirra::scheduler::acquire().uninitialize();
 			mirra::cpu::acquire().uninitialize();
+			mirra::ppu::acquire().uninitialize();
+			mirra::mapper::acquire().uninitialize();
+			mirra::rom::acquire().uninitialize();
+			mirra::database::acquire().uninitialize();
+			mirra::mmu::acquire().uninitialize();
 			mirra::input::acquire().uninitialize();
 			mirra::display::acquire().uninitialize();
 			m_parameter_initialize.clear();
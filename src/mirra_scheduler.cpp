@@ -0,0 +1,313 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include "../include/mirra_scheduler.h"
+#include "mirra_scheduler_type.h"
+
+namespace mirra {
+
+	static const std::string SCHEDULER_EVENT_STR[] = {
+		"APU", "MAPPER", "PPU",
+		};
+
+	#define SCHEDULER_EVENT_STRING(_TYPE_) \
+		((_TYPE_) > SCHEDULER_EVENT_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(SCHEDULER_EVENT_STR[_TYPE_]))
+
+	#define SCHEDULER_RUN_MAX ((uint64_t) UINT32_MAX)
+
+	scheduler::scheduler(void) :
+		mirra::singleton<mirra::scheduler>(OBJECT_SCHEDULER),
+		m_cpu(mirra::cpu::acquire()),
+		m_initialized(false),
+		m_next(SCHEDULER_CYCLE_NEVER),
+		m_started(false)
+	{
+		clear();
+	}
+
+	scheduler::~scheduler(void)
+	{
+		uninitialize();
+	}
+
+	void 
+	scheduler::attach(
+		__in mirra::scheduler_event_t event,
+		__in mirra::scheduler_handler *handler
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(event > SCHEDULER_EVENT_MAX) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION_FORMAT(MIRRA_SCHEDULER_EXCEPTION_INVALID_EVENT,
+				"%x", event);
+		}
+
+		m_entry[event].handler = handler;
+	}
+
+	void 
+	scheduler::cancel(
+		__in mirra::scheduler_event_t event
+		)
+	{
+		schedule(event, SCHEDULER_CYCLE_NEVER);
+	}
+
+	void 
+	scheduler::clear(void)
+	{
+		uint32_t iter;
+
+		for(iter = 0; iter <= SCHEDULER_EVENT_MAX; ++iter) {
+			m_entry[iter].cycle = SCHEDULER_CYCLE_NEVER;
+		}
+
+		m_next = SCHEDULER_CYCLE_NEVER;
+	}
+
+	void 
+	scheduler::detach(
+		__in mirra::scheduler_event_t event
+		)
+	{
+		attach(event, nullptr);
+	}
+
+	void 
+	scheduler::dispatch(void)
+	{
+		uint32_t iter;
+		uint64_t current, deadline;
+
+		current = cycle();
+
+		while(m_next <= current) {
+
+			for(iter = 0; iter <= SCHEDULER_EVENT_MAX; ++iter) {
+
+				if(m_entry[iter].cycle == m_next) {
+					break;
+				}
+			}
+
+			deadline = m_next;
+			m_entry[iter].cycle = SCHEDULER_CYCLE_NEVER;
+			update();
+
+			if(m_entry[iter].handler) {
+				m_entry[iter].handler->fire((mirra::scheduler_event_t) iter, deadline);
+			}
+		}
+	}
+
+	void 
+	scheduler::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+		uint32_t iter;
+
+		if(m_initialized) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_INITIALIZED);
+		}
+
+		for(iter = 0; iter <= SCHEDULER_EVENT_MAX; ++iter) {
+			m_entry[iter].handler = nullptr;
+		}
+
+		clear();
+		m_initialized = true;
+	}
+
+	bool 
+	scheduler::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	scheduler::is_started(void)
+	{
+		return m_started;
+	}
+
+	mirra::cpu_event_t 
+	scheduler::run(
+		__in uint64_t cycles
+		)
+	{
+		uint64_t current, target;
+		mirra::cpu_event_t result = CPU_EVENT_NONE;
+
+		if(!m_initialized) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(!m_started) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_STOPPED);
+		}
+
+		target = (cycle() + cycles);
+
+		while(((current = cycle()) < target) && (result == CPU_EVENT_NONE)) {
+
+			if(m_next > current) {
+				result = m_cpu.run_for(std::min(SCHEDULER_CPU_CYCLES(std::min(m_next, target) - current),
+					SCHEDULER_RUN_MAX));
+			}
+
+			dispatch();
+
+			if(result == CPU_EVENT_NONE) {
+				result = m_cpu.event();
+			}
+		}
+
+		return result;
+	}
+
+	mirra::cpu_event_t 
+	scheduler::run_until(
+		__in mirra::cpu_event_t event
+		)
+	{
+		mirra::cpu_event_t result;
+
+		do {
+			result = run(SCHEDULER_FRAME_CYCLES);
+		} while((result != event) && (result != CPU_EVENT_BREAKPOINT) && (result != CPU_EVENT_HALT));
+
+		return result;
+	}
+
+	void 
+	scheduler::schedule(
+		__in mirra::scheduler_event_t event,
+		__in uint64_t cycle
+		)
+	{
+
+		if(event > SCHEDULER_EVENT_MAX) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION_FORMAT(MIRRA_SCHEDULER_EXCEPTION_INVALID_EVENT,
+				"%x", event);
+		}
+
+		m_entry[event].cycle = cycle;
+
+		if(cycle < m_next) {
+			m_next = cycle;
+			m_cpu.limit(SCHEDULER_CPU_CYCLES(cycle));
+		} else {
+			update();
+		}
+	}
+
+	void 
+	scheduler::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_STARTED);
+		}
+
+		clear();
+		m_started = true;
+	}
+
+	void 
+	scheduler::stop(void)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_SCHEDULER_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			clear();
+			m_started = false;
+		}
+	}
+
+	std::string 
+	scheduler::to_string(
+		__in_opt bool verbose
+		)
+	{
+		uint32_t iter;
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this);
+
+			if(m_started) {
+				result << ", CYCLE=" << cycle();
+
+				for(iter = 0; iter <= SCHEDULER_EVENT_MAX; ++iter) {
+					result << ", " << SCHEDULER_EVENT_STRING(iter) << "=";
+
+					if(m_entry[iter].cycle != SCHEDULER_CYCLE_NEVER) {
+						result << m_entry[iter].cycle;
+					} else {
+						result << "-";
+					}
+				}
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	scheduler::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_initialized = false;
+		}
+	}
+
+	void 
+	scheduler::update(void)
+	{
+		uint32_t iter;
+
+		m_next = SCHEDULER_CYCLE_NEVER;
+
+		for(iter = 0; iter <= SCHEDULER_EVENT_MAX; ++iter) {
+			m_next = std::min(m_next, m_entry[iter].cycle);
+		}
+	}
+}
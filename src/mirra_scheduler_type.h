@@ -0,0 +1,63 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRA_SCHEDULER_TYPE_H_
+#define MIRRA_SCHEDULER_TYPE_H_
+
+#include "../include/mirra_exception.h"
+
+namespace mirra {
+
+	#define MIRRA_SCHEDULER_HEADER "[MIRRA::SCHEDULER]"
+
+#ifndef NDEBUG
+	#define MIRRA_SCHEDULER_EXCEPTION_HEADER MIRRA_SCHEDULER_HEADER " "
+#else
+	#define MIRRA_SCHEDULER_EXCEPTION_HEADER
+#endif // NDEBUG
+
+	enum {
+		MIRRA_SCHEDULER_EXCEPTION_INITIALIZED = 0,
+		MIRRA_SCHEDULER_EXCEPTION_INVALID_EVENT,
+		MIRRA_SCHEDULER_EXCEPTION_STARTED,
+		MIRRA_SCHEDULER_EXCEPTION_STOPPED,
+		MIRRA_SCHEDULER_EXCEPTION_UNINITIALIZED,
+	};
+
+	#define MIRRA_SCHEDULER_EXCEPTION_MAX MIRRA_SCHEDULER_EXCEPTION_UNINITIALIZED
+
+	static const std::string MIRRA_SCHEDULER_EXCEPTION_STR[] = {
+		MIRRA_SCHEDULER_EXCEPTION_HEADER "Scheduler is initialized",
+		MIRRA_SCHEDULER_EXCEPTION_HEADER "Invalid scheduler event",
+		MIRRA_SCHEDULER_EXCEPTION_HEADER "Scheduler is started",
+		MIRRA_SCHEDULER_EXCEPTION_HEADER "Scheduler is stopped",
+		MIRRA_SCHEDULER_EXCEPTION_HEADER "Scheduler is uninitialized",
+		};
+
+	#define MIRRA_SCHEDULER_EXCEPTION_STRING(_TYPE_) \
+		((_TYPE_) > MIRRA_SCHEDULER_EXCEPTION_MAX ? MIRRA_SCHEDULER_EXCEPTION_HEADER EXCEPTION_UNKNOWN : \
+		STRING_CHECK(MIRRA_SCHEDULER_EXCEPTION_STR[_TYPE_]))
+
+	#define THROW_MIRRA_SCHEDULER_EXCEPTION(_EXCEPT_) \
+		THROW_EXCEPTION(MIRRA_SCHEDULER_EXCEPTION_STRING(_EXCEPT_))
+	#define THROW_MIRRA_SCHEDULER_EXCEPTION_FORMAT(_EXCEPT_, _FORMAT_, ...) \
+		THROW_EXCEPTION_FORMAT(MIRRA_SCHEDULER_EXCEPTION_STRING(_EXCEPT_), _FORMAT_, __VA_ARGS__)
+}
+
+#endif // MIRRA_SCHEDULER_TYPE_H_
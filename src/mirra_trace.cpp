@@ -0,0 +1,319 @@
+/**
+ * mirra
+ * Copyright (C) 2016 David Jolly
+ * ----------------------
+ *
+ * mirra is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * mirra is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include "../include/mirra_cpu.h"
+#include "../include/mirra_trace.h"
+#include "mirra_trace_type.h"
+
+namespace mirra {
+
+	static const std::string TRACE_FORMAT_STR[] = {
+		"TEXT", "BINARY",
+		};
+
+	#define TRACE_FORMAT_STRING(_TYPE_) \
+		((_TYPE_) > TRACE_FORMAT_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(TRACE_FORMAT_STR[_TYPE_]))
+
+	static const char *TRACE_OPERAND_FMT[] = {
+		"$%04X", "$%04X,X", "$%04X,Y", "A", "#$%02X",
+		"", "($%04X)", "($%02X,X)", "($%02X),Y", "$%04X",
+		"$%02X", "$%02X,X", "$%02X,Y",
+		};
+
+	static const std::string TRACE_PARAMETER_STR[] = {
+		"FORMAT", "PATH",
+		};
+
+	#define TRACE_PARAMETER_STRING(_TYPE_) \
+		((_TYPE_) > TRACE_PARAMETER_MAX ? STRING_UNKNOWN : \
+		STRING_CHECK(TRACE_PARAMETER_STR[_TYPE_]))
+
+	#define TRACE_BATCH_MAX 0x1000
+	#define TRACE_IDLE_TIMEOUT 1
+	#define TRACE_LINE_MAX 128
+	#define TRACE_PARAMETER_DEFAULT_FORMAT TRACE_FORMAT_TEXT
+	#define TRACE_PARAMETER_DEFAULT_PATH "mirra.trace"
+
+	trace::trace(void) :
+		mirra::singleton<mirra::trace>(OBJECT_TRACE),
+		m_active(false),
+		m_format(TRACE_PARAMETER_DEFAULT_FORMAT),
+		m_head(0),
+		m_initialized(false),
+		m_lost(0),
+		m_started(false),
+		m_tail(0)
+	{
+		return;
+	}
+
+	trace::~trace(void)
+	{
+		uninitialize();
+	}
+
+	void 
+	trace::initialize(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+
+		if(m_initialized) {
+			THROW_MIRRA_TRACE_EXCEPTION(MIRRA_TRACE_EXCEPTION_INITIALIZED);
+		}
+
+		m_batch.resize(TRACE_BATCH_MAX);
+		m_ring.resize(TRACE_RING_SIZE);
+		m_initialized = true;
+	}
+
+	bool 
+	trace::is_initialized(void)
+	{
+		return m_initialized;
+	}
+
+	bool 
+	trace::is_started(void)
+	{
+		return m_started;
+	}
+
+	void 
+	trace::output(
+		__in const mirra::trace_record_t *record,
+		__in uint32_t count
+		)
+	{
+		int length;
+		uint8_t iter;
+		uint16_t operand;
+		char bytes[TRACE_LINE_MAX], line[TRACE_LINE_MAX], text[TRACE_LINE_MAX];
+
+		if(m_format == TRACE_FORMAT_BINARY) {
+			m_file.write((const char *) record, count * sizeof(mirra::trace_record_t));
+		} else {
+
+			for(; count; --count, ++record) {
+				const mirra::instruction_t &entry = mirra::cpu::instruction(record->opcode);
+
+				switch(entry.length) {
+					case 1:
+						std::snprintf(bytes, TRACE_LINE_MAX, "%02X %02X", record->opcode,
+							record->operand & UINT8_MAX);
+						break;
+					case 2:
+						std::snprintf(bytes, TRACE_LINE_MAX, "%02X %02X %02X", record->opcode,
+							record->operand & UINT8_MAX, record->operand >> CHAR_BIT);
+						break;
+					default:
+						std::snprintf(bytes, TRACE_LINE_MAX, "%02X", record->opcode);
+						break;
+				}
+
+				operand = record->operand;
+				if(entry.mode == ADDRESS_RELATIVE) {
+					operand = (record->program_counter + entry.length + 1 + (int8_t) operand);
+				}
+
+				length = std::snprintf(text, TRACE_LINE_MAX, "%s ", entry.name);
+				for(iter = 0; iter < length; ++iter) {
+					text[iter] = std::toupper(text[iter]);
+				}
+
+				std::snprintf(text + length, TRACE_LINE_MAX - length, TRACE_OPERAND_FMT[entry.mode], operand);
+				length = std::snprintf(line, TRACE_LINE_MAX,
+					"%04X  %-8s  %-31s A:%02X X:%02X Y:%02X P:%02X SP:%02X CYC:%llu\n",
+					record->program_counter, bytes, text, record->accumulator, record->index_x,
+					record->index_y, record->flag, record->stack_pointer,
+					(unsigned long long) record->cycles);
+				m_file.write(line, length);
+			}
+		}
+	}
+
+	void 
+	trace::run(
+		__in mirra::trace &context
+		)
+	{
+		bool active;
+		uint32_t count, head, length, offset, skip;
+
+		for(;;) {
+			active = context.m_active.load();
+			head = context.m_head.load(std::memory_order_acquire);
+			offset = context.m_tail.load(std::memory_order_relaxed);
+
+			if(head != offset) {
+
+				if((head - offset) > TRACE_RING_SIZE) {
+					context.m_lost += ((head - offset) - TRACE_RING_SIZE);
+					offset = (head - TRACE_RING_SIZE);
+				}
+
+				count = std::min(head - offset, (uint32_t) TRACE_BATCH_MAX);
+
+				for(skip = 0; skip < count; skip += length) {
+					length = std::min(count - skip, TRACE_RING_SIZE - ((offset + skip) & TRACE_RING_MASK));
+					std::copy(&context.m_ring[(offset + skip) & TRACE_RING_MASK],
+						&context.m_ring[(offset + skip) & TRACE_RING_MASK] + length, &context.m_batch[skip]);
+				}
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				head = context.m_head.load(std::memory_order_relaxed);
+				skip = (((head - offset) >= TRACE_RING_SIZE)
+					? std::min(count, (head - offset) - TRACE_RING_SIZE + 1) : 0);
+				context.m_lost += skip;
+				context.output(&context.m_batch[skip], count - skip);
+				context.m_tail.store(offset + count, std::memory_order_release);
+			} else if(active) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(TRACE_IDLE_TIMEOUT));
+			} else {
+				break;
+			}
+		}
+
+		context.m_file.flush();
+	}
+
+	void 
+	trace::start(
+		__in_opt const mirra::parameter_t &parameter
+		)
+	{
+		std::string path;
+		mirra::parameter_t::const_iterator iter;
+		mirra::object_parameter_t::const_iterator attribute_iter;
+
+		if(!m_initialized) {
+			THROW_MIRRA_TRACE_EXCEPTION(MIRRA_TRACE_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			THROW_MIRRA_TRACE_EXCEPTION(MIRRA_TRACE_EXCEPTION_STARTED);
+		}
+
+		m_format = TRACE_PARAMETER_DEFAULT_FORMAT;
+		path = TRACE_PARAMETER_DEFAULT_PATH;
+
+		iter = parameter.find(OBJECT_TRACE);
+		if(iter != parameter.end()) {
+
+			attribute_iter = iter->second.find(TRACE_PARAMETER_FORMAT);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_UNSIGNED)
+						|| (attribute_iter->second.data.uvalue > TRACE_FORMAT_MAX)) {
+					THROW_MIRRA_TRACE_EXCEPTION_FORMAT(MIRRA_TRACE_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s <= %u)", TRACE_PARAMETER_STRING(TRACE_PARAMETER_FORMAT),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_UNSIGNED), TRACE_FORMAT_MAX);
+				}
+
+				m_format = (mirra::trace_format_t) attribute_iter->second.data.uvalue;
+			}
+
+			attribute_iter = iter->second.find(TRACE_PARAMETER_PATH);
+			if(attribute_iter != iter->second.end()) {
+
+				if((attribute_iter->second.type != DATA_STRING)
+						|| !attribute_iter->second.data.strvalue) {
+					THROW_MIRRA_TRACE_EXCEPTION_FORMAT(MIRRA_TRACE_EXCEPTION_INVALID_PARAMETER,
+						"%s: %s (expecting %s)", TRACE_PARAMETER_STRING(TRACE_PARAMETER_PATH),
+						DATA_STRING(attribute_iter->second.type), DATA_STRING(DATA_STRING));
+				}
+
+				path = attribute_iter->second.data.strvalue;
+			}
+		}
+
+		m_file.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		if(!m_file) {
+			THROW_MIRRA_TRACE_EXCEPTION_FORMAT(MIRRA_TRACE_EXCEPTION_EXTERNAL,
+				"%s", path.c_str());
+		}
+
+		m_head = 0;
+		m_lost = 0;
+		m_tail = 0;
+		m_active = true;
+		m_thread = std::thread(mirra::trace::run, std::ref(*this));
+		m_started = true;
+	}
+
+	void 
+	trace::stop(void)
+	{
+
+		if(!m_initialized) {
+			THROW_MIRRA_TRACE_EXCEPTION(MIRRA_TRACE_EXCEPTION_UNINITIALIZED);
+		}
+
+		if(m_started) {
+			m_started = false;
+			m_active = false;
+			m_thread.join();
+			m_file.close();
+		}
+	}
+
+	std::string 
+	trace::to_string(
+		__in_opt bool verbose
+		)
+	{
+		std::stringstream result;
+
+		result << mirra::object::as_string(*this, verbose)
+			<< " (" << (m_initialized ? "INIT" : "UNINIT")
+			<< ", " << (m_started ? "START" : "STOP") << ")";
+
+		if(m_initialized) {
+			result << " INST=" << SCALAR_AS_HEX(uintptr_t, this)
+				<< ", RING=" << SCALAR_AS_HEX(uintptr_t, &m_ring[0]) << " (" << m_ring.size() << " records)";
+
+			if(m_started) {
+				result << ", FMT=" << TRACE_FORMAT_STRING(m_format)
+					<< ", PEND=" << std::min(m_head - m_tail, (uint32_t) TRACE_RING_SIZE)
+					<< ", LOST=" << m_lost;
+			}
+		}
+
+		return result.str();
+	}
+
+	void 
+	trace::uninitialize(void)
+	{
+
+		if(m_initialized) {
+			stop();
+			m_batch.clear();
+			m_batch.shrink_to_fit();
+			m_ring.clear();
+			m_ring.shrink_to_fit();
+			m_initialized = false;
+		}
+	}
+}
@@ -17,8 +17,320 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "../include/mirra_cpu.h"
 #include "../include/mirra_runtime.h"
 
+#define TEST_FLAT_ADDRESS MMU_RAM_SIZE
+#define TEST_FLAT_SIZE (BUS_WORD_MAX + 1)
+#define TEST_LIMIT_DEFAULT 0x100000000ULL
+#define TEST_OPCODE_BRANCH_MASK 0x1f
+#define TEST_OPCODE_BRANCH 0x10
+#define TEST_OPCODE_JMP 0x4c
+#define TEST_OFFSET_SELF 0xfe
+#define TEST_STATUS_MASK 0xcf
+#define TEST_SLICE_CYCLES 0x10000
+
+typedef struct {
+	uint16_t entry;
+	bool entry_set;
+	std::vector<uint8_t> image;
+	uint64_t limit;
+	std::string log;
+	uint16_t origin;
+	uint32_t offset;
+	uint16_t success;
+	bool success_set;
+} test_t;
+
+typedef struct {
+	uint64_t cycles;
+	bool halted;
+	uint64_t instructions;
+	mirra::cpu_register_t registers;
+	double seconds;
+	bool trapped;
+} test_result_t;
+
+static std::vector<uint8_t> g_flat;
+
+void 
+test_start(
+	__in const test_t &test,
+	__in mirra::engine_t engine
+	)
+{
+	uint32_t address, iter;
+	mirra::parameter_t parameter;
+	mirra::mmu &mmu = mirra::mmu::acquire();
+	mirra::cpu &cpu = mirra::cpu::acquire();
+	mirra::cpu_register_t registers;
+
+	g_flat.assign(TEST_FLAT_SIZE, 0);
+
+	for(iter = test.offset, address = test.origin; (iter < test.image.size()) && (address < TEST_FLAT_SIZE);
+			++iter, ++address) {
+		g_flat[address] = test.image[iter];
+	}
+
+	parameter[mirra::OBJECT_CPU][mirra::CPU_PARAMETER_ENGINE] = {mirra::DATA_UNSIGNED};
+	parameter[mirra::OBJECT_CPU][mirra::CPU_PARAMETER_ENGINE].data.uvalue = engine;
+	mmu.initialize();
+	mmu.start();
+	std::memcpy(mmu.ram(), &g_flat[0], TEST_FLAT_ADDRESS);
+	mmu.map(TEST_FLAT_ADDRESS, TEST_FLAT_SIZE - TEST_FLAT_ADDRESS, &g_flat[TEST_FLAT_ADDRESS],
+		&g_flat[TEST_FLAT_ADDRESS]);
+	cpu.initialize(parameter);
+	cpu.start();
+
+	if(test.entry_set) {
+		registers = cpu.registers();
+		registers.program_counter = test.entry;
+		cpu.registers(registers);
+	}
+}
+
+void 
+test_stop(void)
+{
+	mirra::cpu::acquire().uninitialize();
+	mirra::mmu::acquire().uninitialize();
+}
+
+bool 
+test_trapped(
+	__in uint16_t address
+	)
+{
+	uint8_t opcode;
+	mirra::mmu &mmu = mirra::mmu::acquire();
+
+	opcode = mmu.read(address);
+	if(opcode == TEST_OPCODE_JMP) {
+		return ((mmu.read(address + 1) | (mmu.read(address + 2) << CHAR_BIT)) == address);
+	}
+
+	return (((opcode & TEST_OPCODE_BRANCH_MASK) == TEST_OPCODE_BRANCH)
+		&& (mmu.read(address + 1) == TEST_OFFSET_SELF));
+}
+
+test_result_t 
+test_run(
+	__in const test_t &test,
+	__in mirra::engine_t engine,
+	__in bool step
+	)
+{
+	uint16_t address;
+	test_result_t result = {};
+	mirra::cpu &cpu = mirra::cpu::acquire();
+	std::chrono::steady_clock::time_point begin;
+
+	test_start(test, engine);
+	begin = std::chrono::steady_clock::now();
+
+	do {
+		address = cpu.registers().program_counter;
+
+		if(step) {
+			result.halted = (cpu.run_for(1) == mirra::CPU_EVENT_HALT);
+			++result.instructions;
+			result.trapped = (cpu.registers().program_counter == address);
+		} else {
+			result.halted = (cpu.run_for(TEST_SLICE_CYCLES) == mirra::CPU_EVENT_HALT);
+			result.trapped = (result.halted
+				|| ((cpu.registers().program_counter == address) && test_trapped(address)));
+		}
+	} while(!result.trapped && (cpu.cycles() < test.limit));
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	result.cycles = cpu.cycles();
+	result.registers = cpu.registers();
+	test_stop();
+
+	return result;
+}
+
+int 
+test_log(
+	__in const test_t &test
+	)
+{
+	int result = 0;
+	std::string line;
+	std::ifstream file;
+	std::size_t position;
+	uint64_t cycles = 0, count = 0;
+	mirra::cpu &cpu = mirra::cpu::acquire();
+	mirra::cpu_register_t expected, actual;
+
+	file.open(test.log.c_str(), std::ios::in);
+	if(!file) {
+		std::cerr << "Failed to open log: " << test.log << std::endl;
+		return SCALAR_INVALID(int);
+	}
+
+	test_start(test, mirra::ENGINE_TABLE);
+
+	while(std::getline(file, line)) {
+
+		if(line.size() < 4) {
+			continue;
+		}
+
+		expected.program_counter = std::stoul(line.substr(0, 4), nullptr, 16);
+
+		if(((position = line.find("A:")) == std::string::npos)
+				|| (position + 24 > line.size())) {
+			std::cerr << "Malformed log line " << (count + 1) << ": " << line << std::endl;
+			result = SCALAR_INVALID(int);
+			break;
+		}
+
+		expected.accumulator = std::stoul(line.substr(position + 2, 2), nullptr, 16);
+		expected.index_x = std::stoul(line.substr(position + 7, 2), nullptr, 16);
+		expected.index_y = std::stoul(line.substr(position + 12, 2), nullptr, 16);
+		expected.flag = std::stoul(line.substr(position + 17, 2), nullptr, 16);
+		expected.stack_pointer = std::stoul(line.substr(position + 23, 2), nullptr, 16);
+
+		if(!count) {
+			cpu.registers(expected);
+		}
+
+		position = line.find("CYC:");
+		if((position != std::string::npos) && !count) {
+			cycles = (std::stoull(line.substr(position + 4)) - cpu.cycles());
+		}
+
+		actual = cpu.registers();
+
+		if((actual.program_counter != expected.program_counter)
+				|| (actual.accumulator != expected.accumulator)
+				|| (actual.index_x != expected.index_x)
+				|| (actual.index_y != expected.index_y)
+				|| ((actual.flag & TEST_STATUS_MASK) != (expected.flag & TEST_STATUS_MASK))
+				|| (actual.stack_pointer != expected.stack_pointer)
+				|| ((position != std::string::npos)
+					&& (std::stoull(line.substr(position + 4)) != (cpu.cycles() + cycles)))) {
+			std::cerr << "Mismatch at line " << (count + 1) << std::endl
+				<< "  expected: " << line << std::endl
+				<< "  actual:   " << std::uppercase << SCALAR_AS_HEX(uint16_t, actual.program_counter)
+				<< " A:" << SCALAR_AS_HEX(uint8_t, actual.accumulator)
+				<< " X:" << SCALAR_AS_HEX(uint8_t, actual.index_x)
+				<< " Y:" << SCALAR_AS_HEX(uint8_t, actual.index_y)
+				<< " P:" << SCALAR_AS_HEX(uint8_t, actual.flag)
+				<< " SP:" << SCALAR_AS_HEX(uint8_t, actual.stack_pointer)
+				<< " CYC:" << std::nouppercase << (cpu.cycles() + cycles) << std::endl;
+			result = SCALAR_INVALID(int);
+			break;
+		}
+
+		cpu.run_for(1);
+		++count;
+	}
+
+	test_stop();
+	std::cout << "Log: " << count << " instructions matched (" << test.log << ")" << std::endl;
+
+	return result;
+}
+
+int 
+test(
+	__in int count,
+	__in char *argument[]
+	)
+{
+	int result = 0;
+	std::ifstream file;
+	uint32_t engine_begin = mirra::ENGINE_TABLE, engine_end = mirra::ENGINE_MAX, iter;
+	test_t test = {};
+	test_result_t reference, current;
+
+	test.limit = TEST_LIMIT_DEFAULT;
+
+	for(iter = 2; iter < (uint32_t) count; ++iter) {
+		std::string option = argument[iter];
+
+		if(iter + 1 >= (uint32_t) count) {
+			std::cerr << "Missing value: " << option << std::endl;
+			return SCALAR_INVALID(int);
+		}
+
+		if(option == "--engine") {
+			engine_begin = engine_end = std::stoul(argument[++iter], nullptr, 0);
+		} else if(option == "--entry") {
+			test.entry = std::stoul(argument[++iter], nullptr, 0);
+			test.entry_set = true;
+		} else if(option == "--limit") {
+			test.limit = std::stoull(argument[++iter], nullptr, 0);
+		} else if(option == "--log") {
+			test.log = argument[++iter];
+		} else if(option == "--offset") {
+			test.offset = std::stoul(argument[++iter], nullptr, 0);
+		} else if(option == "--origin") {
+			test.origin = std::stoul(argument[++iter], nullptr, 0);
+		} else if(option == "--success") {
+			test.success = std::stoul(argument[++iter], nullptr, 0);
+			test.success_set = true;
+		} else {
+			std::cerr << "Unknown option: " << option << std::endl;
+			return SCALAR_INVALID(int);
+		}
+	}
+
+	if(engine_end > mirra::ENGINE_MAX) {
+		std::cerr << "Invalid engine: " << engine_end << std::endl;
+		return SCALAR_INVALID(int);
+	}
+
+	file.open(argument[1], std::ios::in | std::ios::binary);
+	if(!file) {
+		std::cerr << "Failed to open image: " << argument[1] << std::endl;
+		return SCALAR_INVALID(int);
+	}
+
+	test.image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+	if(!test.log.empty()) {
+		return test_log(test);
+	}
+
+	reference = test_run(test, mirra::ENGINE_TABLE, true);
+	std::cout << "Image: " << argument[1] << ", " << reference.instructions << " instructions, "
+		<< reference.cycles << " cycles, PC=" << SCALAR_AS_HEX(uint16_t, reference.registers.program_counter)
+		<< (reference.halted ? " (halted)" : (reference.trapped ? " (trapped)" : " (limit)")) << std::endl;
+
+	if(test.success_set && (!reference.trapped || (reference.registers.program_counter != test.success))) {
+		std::cerr << "Failed: expecting trap at " << SCALAR_AS_HEX(uint16_t, test.success) << std::endl;
+		result = SCALAR_INVALID(int);
+	}
+
+	for(iter = engine_begin; iter <= engine_end; ++iter) {
+		current = test_run(test, (mirra::engine_t) iter, false);
+		std::cout << "Engine " << iter << ": " << std::fixed << std::setprecision(3)
+			<< (current.seconds ? ((reference.instructions / current.seconds) / 1000000.0) : 0.0) << " MIPS, "
+			<< (current.seconds ? ((current.cycles / current.seconds) / 1000000.0) : 0.0) << " MCPS, "
+			<< current.seconds << " sec" << std::defaultfloat << std::endl;
+
+		if((current.registers.program_counter != reference.registers.program_counter)
+				|| (current.registers.accumulator != reference.registers.accumulator)
+				|| (current.registers.index_x != reference.registers.index_x)
+				|| (current.registers.index_y != reference.registers.index_y)
+				|| (current.registers.flag != reference.registers.flag)
+				|| (current.registers.stack_pointer != reference.registers.stack_pointer)
+				|| (current.halted != reference.halted)
+				|| !current.trapped) {
+			std::cerr << "Engine " << iter << ": final state differs from single-step reference" << std::endl;
+			result = SCALAR_INVALID(int);
+		}
+	}
+
+	return result;
+}
+
 /*void 
 setup(
 	__inout mirra::parameter_t &configuration
@@ -43,7 +355,10 @@ setup(
 }*/
 
 int 
-main(void)
+main(
+	__in int count,
+	__in char *argument[]
+	)
 {
 	int result = 0;
 	std::string title;
@@ -52,6 +367,21 @@ main(void)
 	title = mirra::version(true);
 	std::cout << title << std::endl;
 
+	if(count > 1) {
+
+		try {
+			result = test(count, argument);
+		} catch(mirra::exception &exc) {
+			std::cerr << exc.to_string(true) << std::endl;
+			result = SCALAR_INVALID(int);
+		} catch(std::exception &exc) {
+			std::cerr << exc.what() << std::endl;
+			result = SCALAR_INVALID(int);
+		}
+
+		return result;
+	}
+
 	try {
 		mirra::runtime &instance = mirra::runtime::acquire();
 		instance.initialize();